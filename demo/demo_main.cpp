@@ -17,17 +17,33 @@
 
 #include <Arduino.h>
 #include <Servo.h>
+#include <Actuators.h>
+#include <AdcSampler.h>
+#include <Board.h>
+#include <Log.h>
+#include <MemoryMonitor.h>
+#include <MessageLog.h>
+#include <SensorConversion.h>
+#include <ServoMotion.h>
 
-// ============= 핀 정의 =============
-#define TEMP_SENSOR_PIN A4      // KY-013 아날로그 온도센서 핀
-#define RAIN_SENSOR_PIN A0      // 빗물 감지 센서 (아날로그)
-#define WATER_LEVEL_PIN A3      // 물탱크 수위 센서 (아날로그)
-#define SERVO_PIN 9             // 파라솔 구동 서보모터 
-#define RELAY_PIN 6             // 릴레이 모듈 제어 핀
+// ADC 샘플러 슬롯
+enum AdcSlot {
+    ADC_TEMP,
+    ADC_RAIN,
+    ADC_WATER,
+    ADC_SLOT_COUNT
+};
+const uint8_t ADC_PINS[ADC_SLOT_COUNT] = {
+    TEMP_SENSOR_PIN, RAIN_SENSOR_PIN, WATER_LEVEL_PIN
+};
 
 // ============= 객체 초기화 =============
 Servo parasolServo;
 
+// 파라솔 램프 이동 (최고 90도/초, 가속 180도/초², 10ms 틱)
+const uint8_t MOTION_TICK_MS = 10;
+ServoMotion parasolMotion(90, 180, MOTION_TICK_MS);
+
 // ============= 전역 변수 =============
 bool demoMode = false;
 int currentDemo = 0;
@@ -58,22 +74,30 @@ void relayON();
 void relayOFF();
 void readRealSensors();
 void printSensorReadings();
+void updateParasolMotion();
+void moveParasol(uint8_t angle);
 
 void setup() {
     Serial.begin(9600);
+    // 발표 중에는 모든 줄이 보여야 하므로 로그도 Serial.print처럼 기다린다
+    logSetBlocking(true);
     delay(1000);
     
-    Serial.println("╔════════════════════════════════════════╗");
-    Serial.println("║     SmartCool Parasol 데모 시스템     ║");
-    Serial.println("║        발표용 인터랙티브 테스트        ║");
-    Serial.println("╚════════════════════════════════════════╝");
-    Serial.println();
+    // 한 줄이 LOG_LINE_MAX(96) - 줄바꿈 2바이트 안에 들어가야 한다 (═ 하나가 3바이트)
+    LOG_INFO(F("══════════════════════════════"));
+    LOG_INFO(F("SmartCool Parasol 데모 시스템"));
+    LOG_INFO(F("   발표용 인터랙티브 테스트"));
+    LOG_INFO(F("══════════════════════════════"));
+    LOG_INFO();
     
     initializeDemo();
     printMenu();
 }
 
 void loop() {
+    // ISR이 쌓아둔 ADC 샘플 반영
+    adcSampler.drain();
+
     // 시리얼 입력 처리
     handleSerialInput();
     
@@ -81,27 +105,33 @@ void loop() {
     if (demoMode) {
         // 10초 후 자동으로 대기 모드로 복귀
         if (millis() - demoStartTime > 10000) {
-            Serial.println("\n데모 시간 종료 - 대기 모드로 복귀");
+            LOG_INFO();
+            LOGM_INFO(MSG_DEMO_TIMEOUT);
             demoStandbyMode();
             printMenu();
         }
     }
     
-    delay(100);
+    // 파라솔 램프 이동 틱
+    updateParasolMotion();
 }
 
 void initializeDemo() {
-    Serial.println("하드웨어 초기화 중...");
+    LOG_INFO(F("하드웨어 초기화 중..."));
     
     // 핀 설정
-    pinMode(RELAY_PIN, OUTPUT);
+    RelayPin::output();
     relayOFF();
     
     // 서보모터 초기화
     parasolServo.attach(SERVO_PIN);
     parasolServo.write(40);  // 초기 위치 (수납 상태)
+    parasolMotion.reset(40);
     delay(1000);
     
+    // 센서 샘플링 시작 (ISR 라운드로빈)
+    adcSampler.begin(ADC_PINS, ADC_SLOT_COUNT);
+    
     // 상태 초기화
     demo.parasolDeployed = false;
     demo.pumpActive = false;
@@ -110,21 +140,21 @@ void initializeDemo() {
     demo.operationMode = 0;
     
     systemReady = true;
-    Serial.println("시스템 준비 완료!\n");
+    LOG_INFO(F("시스템 준비 완료!\n"));
 }
 
 void printMenu() {
-    Serial.println("┌─────────────────────────────────────┐");
-    Serial.println("│           데모 메뉴 선택            │");
-    Serial.println("├─────────────────────────────────────┤");
-    Serial.println("│ 1  더위 대응 모드                   │");
-    Serial.println("│ 2  빗물 수집 모드                   │");
-    Serial.println("│ 3  미스트 분사 모드                 │");
-    Serial.println("│ 4  파라솔 동작 테스트               │");
-    Serial.println("│ 5  센서 상태 체크                   │");
-    Serial.println("│ 0  대기 모드 (초기화)               │");
-    Serial.println("└─────────────────────────────────────┘");
-    Serial.println("숫자를 입력하고 Enter를 누르세요:");
+    LOG_INFO(F("┌──────────────────────────┐"));
+    LOG_INFO(F("│      데모 메뉴 선택      │"));
+    LOG_INFO(F("├──────────────────────────┤"));
+    LOG_INFO(F("│ 1  더위 대응 모드        │"));
+    LOG_INFO(F("│ 2  빗물 수집 모드        │"));
+    LOG_INFO(F("│ 3  미스트 분사 모드      │"));
+    LOG_INFO(F("│ 4  파라솔 동작 테스트    │"));
+    LOG_INFO(F("│ 5  센서 상태 체크        │"));
+    LOG_INFO(F("│ 0  대기 모드 (초기화)    │"));
+    LOG_INFO(F("└──────────────────────────┘"));
+    LOG_INFO(F("숫자를 입력하고 Enter를 누르세요:"));
 }
 
 void handleSerialInput() {
@@ -134,7 +164,7 @@ void handleSerialInput() {
         if (input >= 0 && input <= 5) {
             executeDemo(input);
         } else {
-            Serial.println("잘못된 입력입니다. 0-5 사이의 숫자를 입력하세요.");
+            LOG_INFO(F("잘못된 입력입니다. 0-5 사이의 숫자를 입력하세요."));
         }
         
         // 시리얼 버퍼 비우기
@@ -149,7 +179,8 @@ void executeDemo(int demoNumber) {
     demoStartTime = millis();
     demoMode = (demoNumber != 0);
     
-    Serial.println("\n" + String("=").substring(0, 50));
+    LOG_INFO();
+    LOG_INFO(F("=================================================="));
     
     switch (demoNumber) {
         case 1:
@@ -172,141 +203,135 @@ void executeDemo(int demoNumber) {
             printMenu();
             break;
         default:
-            Serial.println("지원하지 않는 데모입니다.");
+            LOG_INFO(F("지원하지 않는 데모입니다."));
             break;
     }
 }
 
 void demoHeatResponse() {
-    Serial.println("더위 대응 모드 데모 시작");
-    Serial.println("시나리오: 온도 상승 감지 → 파라솔 전개 → 미스트 분사");
-    Serial.println();
+    LOGM_INFO(MSG_DEMO_START, 0);
+    LOG_INFO(F("시나리오: 온도 상승 감지 → 파라솔 전개 → 미스트 분사"));
+    LOG_INFO();
     
     // 1단계: 온도 상승 시뮬레이션
-    Serial.println("1 온도 상승 감지 중...");
-    Serial.println("   온도: 28°C → 32°C → 35°C");
+    LOG_INFO(F("1 온도 상승 감지 중..."));
+    LOG_INFO(F("   온도: 28°C → 32°C → 35°C"));
     delay(1500);
     
     // 2단계: 파라솔 전개
-    Serial.println("2 파라솔 전개 중...");
-    Serial.println("   차양용 각도로 전개 (90도)");
-    parasolServo.write(90);
+    LOG_INFO(F("2 파라솔 전개 중..."));
+    LOG_INFO(F("   차양용 각도로 전개 (90도)"));
+    moveParasol(90);
     demo.parasolDeployed = true;
     demo.operationMode = 2;
-    delay(2000);
     
     // 3단계: 미스트 분사 시작
-    Serial.println("3 미스트 분사 시작...");
-    Serial.println("   워터펌프 가동 (릴레이 ON)");
+    LOG_INFO(F("3 미스트 분사 시작..."));
+    LOG_INFO(F("   워터펌프 가동 (릴레이 ON)"));
     relayON();
     demo.pumpActive = true;
     demo.heatAlert = true;
     delay(2000);
     
-    Serial.println("더위 대응 모드 활성화 완료!");
-    Serial.println("10초 후 자동으로 대기 모드로 복귀합니다...");
+    LOGM_INFO(MSG_DEMO_ACTIVE, 0);
+    LOG_INFO(F("10초 후 자동으로 대기 모드로 복귀합니다..."));
 }
 
 void demoRainCollection() {
-    Serial.println("빗물 수집 모드 데모 시작");
-    Serial.println("시나리오: 빗물 감지 → 파라솔 전개 → 빗물 수집");
-    Serial.println();
+    LOGM_INFO(MSG_DEMO_START, 1);
+    LOG_INFO(F("시나리오: 빗물 감지 → 파라솔 전개 → 빗물 수집"));
+    LOG_INFO();
     
     // 1단계: 빗물 감지 시뮬레이션
-    Serial.println("1 빗물 감지 중...");
-    Serial.println("   빗물 센서: 800 → 650 → 500 (감지!)");
+    LOG_INFO(F("1 빗물 감지 중..."));
+    LOG_INFO(F("   빗물 센서: 800 → 650 → 500 (감지!)"));
     delay(1500);
     
     // 2단계: 워터펌프 정지 (빗물 수집 우선)
-    Serial.println("2 워터펌프 정지...");
-    Serial.println("   빗물 수집을 위해 미스트 분사 중단");
+    LOG_INFO(F("2 워터펌프 정지..."));
+    LOG_INFO(F("   빗물 수집을 위해 미스트 분사 중단"));
     relayOFF();
     demo.pumpActive = false;
     delay(1000);
     
     // 3단계: 파라솔 전개 (빗물 수집용)
-    Serial.println("3 파라솔 빗물 수집 모드 전개...");
-    Serial.println("   빗물 수집용 각도로 전개 (140도)");
-    parasolServo.write(140);
+    LOG_INFO(F("3 파라솔 빗물 수집 모드 전개..."));
+    LOG_INFO(F("   빗물 수집용 각도로 전개 (140도)"));
+    moveParasol(140);
     demo.parasolDeployed = true;
     demo.rainCollection = true;
     demo.operationMode = 1;
-    delay(2000);
     
-    Serial.println("빗물 수집 모드 활성화 완료!");
-    Serial.println("물탱크에 빗물이 수집되고 있습니다...");
-    Serial.println("10초 후 자동으로 대기 모드로 복귀합니다...");
+    LOGM_INFO(MSG_DEMO_ACTIVE, 1);
+    LOG_INFO(F("물탱크에 빗물이 수집되고 있습니다..."));
+    LOG_INFO(F("10초 후 자동으로 대기 모드로 복귀합니다..."));
 }
 
 void demoMistSpray() {
-    Serial.println("미스트 분사 모드 데모 시작");
-    Serial.println("시나리오: 수위 확인 → 워터펌프 가동 → 미스트 분사");
-    Serial.println();
+    LOGM_INFO(MSG_DEMO_START, 2);
+    LOG_INFO(F("시나리오: 수위 확인 → 워터펌프 가동 → 미스트 분사"));
+    LOG_INFO();
     
     // 1단계: 수위 확인 시뮬레이션
-    Serial.println("1 물탱크 수위 확인 중...");
-    Serial.println("   현재 수위: 75% (임계값 이상)");
+    LOG_INFO(F("1 물탱크 수위 확인 중..."));
+    LOG_INFO(F("   현재 수위: 75% (임계값 이상)"));
     delay(1500);
     
     // 2단계: 워터펌프 가동
-    Serial.println("2 워터펌프 가동...");
-    Serial.println("   릴레이 ON - 미스트 노즐 활성화");
+    LOG_INFO(F("2 워터펌프 가동..."));
+    LOG_INFO(F("   릴레이 ON - 미스트 노즐 활성화"));
     relayON();
     demo.pumpActive = true;
+    demo.operationMode = 3;
     delay(2000);
     
     // 3단계: 미스트 분사 효과 시뮬레이션
-    Serial.println("3 미스트 분사 중...");
-    Serial.println("   시원한 미스트가 분사됩니다");
-    Serial.println("   체감온도 5°C 하락 효과");
+    LOG_INFO(F("3 미스트 분사 중..."));
+    LOG_INFO(F("   시원한 미스트가 분사됩니다"));
+    LOG_INFO(F("   체감온도 5°C 하락 효과"));
     delay(2000);
     
-    Serial.println("미스트 분사 모드 활성화 완료!");
-    Serial.println("쿨링 효과를 확인하세요!");
-    Serial.println("10초 후 자동으로 대기 모드로 복귀합니다...");
+    LOGM_INFO(MSG_DEMO_ACTIVE, 2);
+    LOG_INFO(F("쿨링 효과를 확인하세요!"));
+    LOG_INFO(F("10초 후 자동으로 대기 모드로 복귀합니다..."));
 }
 
 void demoParasolTest() {
-    Serial.println("파라솔 동작 테스트 시작");
-    Serial.println("시나리오: 다양한 각도로 파라솔 동작 테스트");
-    Serial.println();
+    LOGM_INFO(MSG_DEMO_PARASOL_BEGIN);
+    LOG_INFO(F("시나리오: 다양한 각도로 파라솔 동작 테스트"));
+    LOG_INFO();
     
     // 수납 상태에서 시작
-    Serial.println("1 수납 상태 (40도)");
-    parasolServo.write(40);
-    delay(2000);
+    LOG_INFO(F("1 수납 상태 (40도)"));
+    moveParasol(40);
     
     // 차양 모드
-    Serial.println("2 차양 모드 (90도)");
-    parasolServo.write(90);
+    LOG_INFO(F("2 차양 모드 (90도)"));
+    moveParasol(90);
     demo.parasolDeployed = true;
-    delay(2000);
     
     // 빗물 수집 모드
-    Serial.println("3 빗물 수집 모드 (140도)");
-    parasolServo.write(140);
-    delay(2000);
+    LOG_INFO(F("3 빗물 수집 모드 (140도)"));
+    moveParasol(140);
     
     // 최대 전개
-    Serial.println("4 최대 전개 (180도)");
-    parasolServo.write(180);
-    delay(2000);
+    LOG_INFO(F("4 최대 전개 (180도)"));
+    moveParasol(180);
     
     // 원래 위치로 복귀
-    Serial.println("5 수납 위치로 복귀 (40도)");
-    parasolServo.write(40);
+    LOG_INFO(F("5 수납 위치로 복귀 (40도)"));
+    moveParasol(40);
     demo.parasolDeployed = false;
-    delay(2000);
     
-    Serial.println("파라솔 동작 테스트 완료!");
-    Serial.println("5초 후 자동으로 대기 모드로 복귀합니다...");
+    LOGM_INFO(MSG_DEMO_PARASOL_DONE);
+    LOG_INFO(F("5초 후 자동으로 대기 모드로 복귀합니다..."));
     demoStartTime = millis() - 5000; // 5초 후 종료
 }
 
 void demoSystemStatus() {
-    Serial.println("시스템 상태 체크");
-    Serial.println("실시간 센서 데이터 및 시스템 상태 확인");
-    Serial.println();
+    LOG_INFO(F("시스템 상태 체크"));
+    LOG_INFO(F("실시간 센서 데이터 및 시스템 상태 확인"));
+    LOG_INFO();
     
     // 실제 센서 데이터 읽기
     readRealSensors();
@@ -315,25 +340,31 @@ void demoSystemStatus() {
     printSensorReadings();
     
     // 시스템 상태 출력
-    Serial.println("시스템 상태:");
-    Serial.println("   파라솔: " + String(demo.parasolDeployed ? "전개됨" : "수납됨"));
-    Serial.println("   워터펌프: " + String(demo.pumpActive ? "가동중" : "정지"));
-    Serial.println("   동작모드: " + String(demo.operationMode == 0 ? "대기" : 
-                                        demo.operationMode == 1 ? "빗물수집" : 
-                                        demo.operationMode == 2 ? "더위대응" : "알수없음"));
-    
-    Serial.println("\n팁: 다른 데모를 실행해보세요!");
-    Serial.println("10초 후 자동으로 메뉴로 돌아갑니다...");
+    LOG_INFO(F("시스템 상태:"));
+    LOGM_INFO(MSG_DEMO_PARASOL, demo.parasolDeployed);
+    LOGM_INFO(MSG_DEMO_PUMP, demo.pumpActive);
+    LOGM_INFO(MSG_DEMO_MODE, demo.operationMode);
+    
+    // SRAM: 힙은 쓰지 않으므로 0이어야 한다
+    MemoryReport mem;
+    memorySnapshot(mem);
+    LOG_INFO(F("SRAM 상태:"));
+    LOGM_INFO(MSG_DEMO_SRAM_FREE, mem.freeBytes, mem.unusedMinBytes);
+    LOGM_INFO(MSG_DEMO_SRAM_STACK, mem.stackPeakBytes, mem.dataBytes + mem.bssBytes);
+    LOGM_INFO(MSG_DEMO_SRAM_HEAP, mem.heapBytes, heapFragmentationPercent(mem));
+
+    LOG_INFO(F("\n팁: 다른 데모를 실행해보세요!"));
+    LOG_INFO(F("10초 후 자동으로 메뉴로 돌아갑니다..."));
 }
 
 void demoStandbyMode() {
-    Serial.println("대기 모드로 전환");
-    Serial.println("모든 장치를 초기 상태로 복귀");
-    Serial.println();
+    LOG_INFO(F("대기 모드로 전환"));
+    LOG_INFO(F("모든 장치를 초기 상태로 복귀"));
+    LOG_INFO();
     
     // 모든 장치 정지
     relayOFF();
-    parasolServo.write(40);
+    parasolMotion.moveTo(40);   // loop()의 모션 틱이 수납 위치까지 옮긴다
     
     // 상태 초기화
     demo.parasolDeployed = false;
@@ -344,47 +375,69 @@ void demoStandbyMode() {
     
     demoMode = false;
     
-    Serial.println("대기 모드 활성화 완료");
-    Serial.println("모든 시스템이 대기 상태입니다");
-    Serial.println();
+    LOGM_INFO(MSG_DEMO_STANDBY);
+    LOG_INFO(F("모든 시스템이 대기 상태입니다"));
+    LOG_INFO();
 }
 
+// 릴레이 상태가 실제로 바뀔 때만 핀을 쓰고 메시지 출력
 void relayON() {
-    digitalWrite(RELAY_PIN, HIGH);
-    Serial.println("   워터펌프 ON (릴레이 HIGH)");
+    if (actuators.commandRelay(true)) {
+        LOGM_INFO(MSG_DEMO_RELAY, true);
+    }
 }
 
 void relayOFF() {
-    digitalWrite(RELAY_PIN, LOW);
-    Serial.println("   워터펌프 OFF (릴레이 LOW)");
+    if (actuators.commandRelay(false)) {
+        LOGM_INFO(MSG_DEMO_RELAY, false);
+    }
 }
 
 void readRealSensors() {
-    // 실제 센서값 읽기 (참고용)
-    int tempRaw = analogRead(TEMP_SENSOR_PIN);
-    int rainRaw = analogRead(RAIN_SENSOR_PIN);
-    int waterRaw = analogRead(WATER_LEVEL_PIN);
-    
-    // 온도 계산 (KY-013)
-    float voltage = (tempRaw / 1023.0) * 5.0;
-    float temperature = (voltage - 0.5) * 100.0;
-    
-    Serial.println("실시간 센서 데이터:");
-    Serial.println("   온도: " + String(temperature, 1) + "°C (Raw: " + String(tempRaw) + ")");
-    Serial.println("   빗물: " + String(rainRaw) + " (임계값: 700 이하)");
-    Serial.println("   수위: " + String(waterRaw) + " (임계값: 600 이상)");
-    Serial.println();
+    // 실제 센서값 읽기 (참고용, ADC 샘플러의 블록 평균)
+    adcSampler.drain();
+    int tempRaw = adcSampler.average(ADC_TEMP);
+    int rainRaw = adcSampler.average(ADC_RAIN);
+    int waterRaw = adcSampler.average(ADC_WATER);
+    
+    // 온도 계산 (KY-013, 고정소수점)
+    int16_t tempTenths = ky013ToCelsius(tempRaw).tenths();
+    
+    LOG_INFO(F("실시간 센서 데이터:"));
+    LOGM_INFO(MSG_DEMO_TEMP, tenths(tempTenths), tempRaw);
+    LOGM_INFO(MSG_DEMO_RAIN, rainRaw);
+    LOGM_INFO(MSG_DEMO_WATER, waterRaw);
+    LOG_INFO();
 }
 
 void printSensorReadings() {
-    Serial.println("센서 연결 상태:");
-    Serial.println("   KY-013 온도센서 (A4핀)");
-    Serial.println("   빗물감지센서 (A0핀)"); 
-    Serial.println("   수위센서 (A3핀)");
-    Serial.println();
-    
-    Serial.println("액추에이터 상태:");
-    Serial.println("   서보모터 (9핀)");
-    Serial.println("   워터펌프릴레이 (6핀)");
-    Serial.println();
+    LOG_INFO(F("센서 연결 상태:"));
+    LOG_INFO(F("   KY-013 온도센서 (A4핀)"));
+    LOG_INFO(F("   빗물감지센서 (A0핀)"));
+    LOG_INFO(F("   수위센서 (A3핀)"));
+    LOG_INFO();
+    
+    LOG_INFO(F("액추에이터 상태:"));
+    LOG_INFO(F("   서보모터 (9핀)"));
+    LOG_INFO(F("   워터펌프릴레이 (6핀)"));
+    LOG_INFO();
+}
+
+// 10ms마다 모션 플래너를 한 틱 진행하고, 각도가 바뀌면 서보에 반영
+void updateParasolMotion() {
+    static unsigned long lastTick = 0;
+    if (millis() - lastTick < MOTION_TICK_MS) return;
+    lastTick = millis();
+    if (parasolMotion.update()) {
+        parasolServo.write(parasolMotion.angle());
+    }
+}
+
+// 시연 순서를 지키기 위해 도착할 때까지 램프 이동 (고정 delay 대신 실제 도착 시간만큼)
+void moveParasol(uint8_t angle) {
+    parasolMotion.moveTo(angle);
+    LOGM_INFO(MSG_DEMO_ETA, parasolMotion.msToArrival());
+    while (parasolMotion.moving()) {
+        updateParasolMotion();
+    }
 }
@@ -14,21 +14,31 @@
 
 #include <Arduino.h>
 #include <Servo.h>
-
-// 핀 정의
-#define SERVO_PIN 9
-#define RELAY_PIN 6
+#include <Board.h>
+#include <ServoMotion.h>
 
 Servo parasol;
 
+// 파라솔 램프 이동 (최고 90도/초, 가속 180도/초², 10ms 틱)
+const uint8_t MOTION_TICK_MS = 10;
+ServoMotion motion(90, 180, MOTION_TICK_MS);
+
+void updateMotion() {
+    static unsigned long lastTick = 0;
+    if (millis() - lastTick < MOTION_TICK_MS) return;
+    lastTick = millis();
+    if (motion.update()) parasol.write(motion.angle());
+}
+
 void setup() {
     Serial.begin(9600);
     
-    pinMode(RELAY_PIN, OUTPUT);
-    digitalWrite(RELAY_PIN, LOW);
+    RelayPin::output();
+    RelayPin::low();
     
     parasol.attach(SERVO_PIN);
     parasol.write(40); // 수납 위치
+    motion.reset(40);
     
     Serial.println("=== SmartCool Parasol 간단 데모 ===");
     Serial.println("H: 더위모드 | R: 빗물모드 | M: 미스트 | S: 정지");
@@ -36,6 +46,8 @@ void setup() {
 }
 
 void loop() {
+    updateMotion();
+
     if (Serial.available()) {
         char cmd = Serial.read();
         
@@ -66,39 +78,39 @@ void loop() {
 void heatMode() {
     Serial.println("더위 대응 모드");
     Serial.println("→ 파라솔 전개 (90도)");
-    parasol.write(90);
-    delay(2000);
+    motion.moveTo(90);
+    while (motion.moving()) updateMotion();   // 전개 완료 후 미스트 시작
     
     Serial.println("→ 미스트 분사 시작");
-    digitalWrite(RELAY_PIN, HIGH);
+    RelayPin::high();
     Serial.println("더위 모드 활성화!");
 }
 
 void rainMode() {
     Serial.println("빗물 수집 모드");
     Serial.println("→ 워터펌프 정지");
-    digitalWrite(RELAY_PIN, LOW);
+    RelayPin::low();
     delay(500);
     
     Serial.println("→ 파라솔 빗물수집 각도 (140도)");
-    parasol.write(140);
+    motion.moveTo(140);
     Serial.println("빗물 수집 모드 활성화!");
 }
 
 void mistMode() {
     Serial.println("미스트 분사 모드");
     Serial.println("→ 워터펌프 가동");
-    digitalWrite(RELAY_PIN, HIGH);
+    RelayPin::high();
     Serial.println("미스트 분사 중!");
 }
 
 void stopMode() {
     Serial.println("시스템 정지");
     Serial.println("→ 워터펌프 정지");
-    digitalWrite(RELAY_PIN, LOW);
+    RelayPin::low();
     delay(500);
     
     Serial.println("→ 파라솔 수납 (40도)");
-    parasol.write(40);
+    motion.moveTo(40);
     Serial.println("대기 모드");
 }
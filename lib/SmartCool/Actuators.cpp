@@ -0,0 +1,68 @@
+#include "Actuators.h"
+#include "Board.h"
+#include "Hal.h"
+
+ActuatorCache::ActuatorCache(ServoMotion& parasol) : motion(parasol) {
+    invalidate();
+    resetStats();
+}
+
+void ActuatorCache::invalidate() {
+    relayState = STATE_UNKNOWN;
+    parasolKnown = false;
+    servoKnown = false;
+    servoActive = false;
+    servoWrittenAt = 0;
+}
+
+void ActuatorCache::resetStats() {
+    for (uint8_t i = 0; i < ACT_COUNT; i++) {
+        counters[i].applied = 0;
+        counters[i].suppressed = 0;
+    }
+}
+
+bool ActuatorCache::record(ActuatorId id, bool changed) {
+    if (changed) {
+        counters[id].applied++;
+    } else {
+        counters[id].suppressed++;
+    }
+    return changed;
+}
+
+bool ActuatorCache::commandRelay(bool on) {
+    uint8_t state = on ? STATE_ON : STATE_OFF;
+    if (!record(ACT_RELAY, state != relayState)) return false;
+
+    RelayPin::write(on);
+    relayState = state;
+    return true;
+}
+
+bool ActuatorCache::commandParasol(uint8_t angle) {
+    if (!record(ACT_PARASOL, !parasolKnown || angle != parasolTarget)) return false;
+
+    motion.moveTo(angle);
+    parasolTarget = angle;
+    parasolKnown = true;
+    return true;
+}
+
+bool ActuatorCache::writeServo(uint8_t angle) {
+    if (!record(ACT_SERVO, !servoKnown || !servoActive || angle != servoAngle)) return false;
+
+    hal::servoWrite(angle);
+    servoAngle = angle;
+    servoKnown = true;
+    servoActive = true;
+    servoWrittenAt = hal::millis();
+    return true;
+}
+
+bool ActuatorCache::releaseIdleServo(unsigned long idleMs) {
+    if (!servoActive || hal::millis() - servoWrittenAt < idleMs) return false;
+    if (!hal::servoDetach()) return false;
+    servoActive = false;
+    return true;
+}
@@ -0,0 +1,69 @@
+/*
+ * SmartCool Parasol - 액추에이터 명령 캐시
+ *
+ * 제어 로직은 매 주기 "원하는 상태"를 명령하고,
+ * 여기서 마지막으로 실제 적용한 상태와 비교해 바뀐 경우에만 하드웨어를 건드린다.
+ * 같은 명령의 반복은 비교 한 번으로 끝나며, 적용/생략 횟수를 따로 센다.
+ * 파라솔 목표 각도는 생성할 때 받은 모션 플래너로 넘긴다 (전역 actuators는 ControlCore.cpp).
+ */
+
+#ifndef SMARTCOOL_ACTUATORS_H
+#define SMARTCOOL_ACTUATORS_H
+
+#include <stdint.h>
+#include "ServoMotion.h"
+
+struct CommandStats {
+    unsigned long applied;
+    unsigned long suppressed;
+};
+
+enum ActuatorId {
+    ACT_RELAY,          // 워터펌프 릴레이
+    ACT_PARASOL,        // 파라솔 목표 각도 (모션 플래너)
+    ACT_SERVO,          // 서보 펄스 (램프 중 실제 출력)
+    ACT_COUNT
+};
+
+class ActuatorCache {
+public:
+    explicit ActuatorCache(ServoMotion& parasol);
+
+    // 다음 명령은 캐시와 상관없이 반드시 적용 (부팅 직후, 외부에서 직접 구동한 뒤)
+    void invalidate();
+
+    // 하드웨어를 건드렸으면 true
+    bool commandRelay(bool on);
+    bool commandParasol(uint8_t angle);
+    bool writeServo(uint8_t angle);
+
+    // 마지막 서보 출력 후 idleMs 동안 그대로면 펄스를 끊는다 (끊었으면 true).
+    // 다음 writeServo()는 같은 각도여도 다시 붙인다
+    bool releaseIdleServo(unsigned long idleMs);
+    bool servoPowered() const { return servoActive; }
+
+    bool relayOn() const { return relayState == STATE_ON; }
+    const CommandStats& stats(ActuatorId id) const { return counters[id]; }
+    void resetStats();
+
+private:
+    static const uint8_t STATE_UNKNOWN = 0xFF;
+    static const uint8_t STATE_OFF = 0;
+    static const uint8_t STATE_ON = 1;
+
+    bool record(ActuatorId id, bool changed);
+
+    ServoMotion& motion;     // 파라솔 모션 플래너
+    uint8_t relayState;
+    uint8_t parasolTarget;
+    uint8_t servoAngle;
+    bool parasolKnown;
+    bool servoKnown;
+    bool servoActive;
+    unsigned long servoWrittenAt;
+    CommandStats counters[ACT_COUNT];
+};
+
+extern ActuatorCache actuators;
+
+#endif
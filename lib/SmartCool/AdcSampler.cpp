@@ -0,0 +1,168 @@
+#include "AdcSampler.h"
+#include "Hal.h"
+
+#if defined(__AVR__)
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#endif
+
+AdcSampler adcSampler;
+
+AdcSampler::AdcSampler()
+    : channelCount(0), currentSlot(0), windowSlot(NO_WINDOW), windowTripped(false), windowTrippedAt(0) {
+}
+
+void AdcSampler::begin(const uint8_t* pins, uint8_t count) {
+    if (count > MAX_CHANNELS) count = MAX_CHANNELS;
+
+    for (uint8_t i = 0; i < count; i++) {
+        Channel& c = channels[i];
+        c.pin = pins[i];
+        c.mux = (pins[i] >= A0) ? pins[i] - A0 : pins[i];
+        c.latest = 0;
+        c.average = 0;
+        c.blockSum = 0;
+        c.blockCount = 0;
+        c.valid = false;
+        c.samples = 0;
+    }
+    channelCount = count;
+    if (count == 0) return;
+
+#if !defined(__AVR__)
+    lastDrainMicros = hal::micros();
+#endif
+
+#if defined(__AVR__)
+    // 분주비는 Arduino init()이 설정한 128 그대로 사용 (125kHz ADC 클럭)
+    ADCSRA |= _BV(ADEN) | _BV(ADIE);
+    startConversion(0);
+#endif
+}
+
+void AdcSampler::end() {
+#if defined(__AVR__)
+    ADCSRA &= ~_BV(ADIE);
+#endif
+    channelCount = 0;
+    clearWindow();
+}
+
+void AdcSampler::startConversion(uint8_t slot) {
+    currentSlot = slot;
+#if defined(__AVR__)
+    // AVcc 기준전압 (analogRead DEFAULT와 동일)
+    ADMUX = _BV(REFS0) | (channels[slot].mux & 0x07);
+    ADCSRA |= _BV(ADSC);
+#endif
+}
+
+// 창 필드는 volatile이 아니라 컴파일러가 windowSlot 쓰기 뒤로 옮길 수 있다.
+// 인터럽트를 막은 채 한 번에 바꿔 ISR이 반쯤 바뀐 창을 보지 않게 한다
+void AdcSampler::setWindow(uint8_t slot, uint16_t below, uint16_t rearm, uint8_t confirm) {
+#if defined(__AVR__)
+    uint8_t sreg = SREG;
+    cli();
+#endif
+    windowBelow = below;
+    windowRearm = rearm;
+    windowConfirm = confirm ? confirm : 1;
+    windowCount = 0;
+    windowArmed = true;
+    windowTripped = false;
+    windowSlot = slot;
+#if defined(__AVR__)
+    SREG = sreg;
+#endif
+}
+
+void AdcSampler::clearWindow() {
+#if defined(__AVR__)
+    uint8_t sreg = SREG;
+    cli();
+#endif
+    windowSlot = NO_WINDOW;
+    windowTripped = false;
+#if defined(__AVR__)
+    SREG = sreg;
+#endif
+}
+
+bool AdcSampler::takeWindowTrip(unsigned long& trippedAt) {
+    if (!windowTripped) return false;
+#if defined(__AVR__)
+    uint8_t sreg = SREG;
+    cli();
+#endif
+    trippedAt = windowTrippedAt;
+    windowTripped = false;
+#if defined(__AVR__)
+    SREG = sreg;
+#endif
+    return true;
+}
+
+// ISR 안에서 변환 하나마다. 비교와 카운터만 하고 나머지는 메인 루프 몫
+void AdcSampler::checkWindow(uint16_t value) {
+    if (value >= windowBelow) {
+        windowCount = 0;
+        if (value >= windowRearm) windowArmed = true;
+        return;
+    }
+    if (!windowArmed || ++windowCount < windowConfirm) return;
+
+    windowArmed = false;
+    windowCount = 0;
+    windowTrippedAt = hal::micros();
+    windowTripped = true;
+}
+
+void AdcSampler::onConversionComplete(uint16_t value) {
+    uint8_t slot = currentSlot;
+    ring.push((Sample)(((uint16_t)slot << 12) | value));
+    if (slot == windowSlot) checkWindow(value);
+
+    uint8_t next = slot + 1;
+    if (next >= channelCount) next = 0;
+    startConversion(next);
+}
+
+void AdcSampler::drain() {
+#if !defined(__AVR__)
+    // 네이티브: ADC 인터럽트 대신 지난 drain 이후 가상 시간 동안 끝났을 변환을
+    // HAL에서 읽어 넣는다. 시계를 크게 건너뛰어도 채널당 한 블록까지만 만든다
+    unsigned long now = hal::micros();
+    unsigned long conversions = (now - lastDrainMicros) / CONVERSION_MICROS;
+    unsigned long limit = (unsigned long)channelCount << AVERAGE_SHIFT;
+    if (conversions > limit) conversions = limit;
+    lastDrainMicros += conversions * CONVERSION_MICROS;
+    if (conversions == limit) lastDrainMicros = now;
+    while (conversions--) {
+        onConversionComplete(hal::analogRead(channels[currentSlot].pin));
+    }
+#endif
+
+    Sample s;
+    while (ring.pop(s)) {
+        uint8_t slot = s >> 12;
+        uint16_t value = s & 0x03FF;
+        if (slot >= channelCount) continue;
+
+        Channel& c = channels[slot];
+        c.latest = value;
+        c.samples++;
+        c.blockSum += value;
+        if (++c.blockCount >= (1 << AVERAGE_SHIFT)) {
+            c.average = c.blockSum >> AVERAGE_SHIFT;
+            c.blockSum = 0;
+            c.blockCount = 0;
+            c.valid = true;
+        }
+    }
+}
+
+#if defined(__AVR__)
+ISR(ADC_vect) {
+    adcSampler.onConversionComplete(ADC);
+}
+#endif
@@ -0,0 +1,94 @@
+/*
+ * SmartCool Parasol - 인터럽트 기반 ADC 샘플러
+ *
+ * ADC 변환 완료 ISR에서 등록된 채널을 라운드로빈으로 돌며 계속 변환한다.
+ * 결과는 SPSC 링 버퍼에 쌓이고, 메인 루프가 drain()으로 비운다.
+ * 변환 사이에는 CPU가 놀고 있으므로 analogRead() + delay() 평균보다
+ * 훨씬 많은 샘플(ADC 클럭 125kHz 기준 약 9.6kHz)을 블로킹 없이 얻는다.
+ *
+ * 창 비교(setWindow): 한 슬롯의 변환값이 경계 아래로 연속해서 떨어지면 ISR에서
+ * 바로 표시한다. 블록 평균/필터/태스크 주기를 거치지 않는 비 시작 빠른 경로용.
+ *
+ * 주의: begin() 이후에는 analogRead()를 섞어 쓰면 안 된다.
+ */
+
+#ifndef SMARTCOOL_ADC_SAMPLER_H
+#define SMARTCOOL_ADC_SAMPLER_H
+
+#include <stdint.h>
+#include "RingBuffer.h"
+
+class AdcSampler {
+public:
+    static const uint8_t MAX_CHANNELS = 6;
+    static const uint8_t AVERAGE_SHIFT = 4;   // 16샘플 블록 평균
+    static const uint8_t CONVERSION_MICROS = 104;  // 13 ADC 클럭 @ 125kHz
+
+    // 샘플은 (슬롯 << 12) | 10비트 값 으로 묶어 2바이트에 저장
+    typedef uint16_t Sample;
+
+    AdcSampler();
+
+    // pins: 아날로그 핀(A0~A5) 목록. 슬롯 번호는 배열 순서
+    void begin(const uint8_t* pins, uint8_t count);
+    void end();
+
+    // 메인 루프에서 호출. 쌓인 샘플을 모두 꺼내 채널별 값을 갱신
+    void drain();
+
+    uint16_t latest(uint8_t slot) const { return channels[slot].latest; }
+    uint16_t average(uint8_t slot) const { return channels[slot].average; }
+    bool ready(uint8_t slot) const { return channels[slot].valid; }
+    unsigned long sampleCount(uint8_t slot) const { return channels[slot].samples; }
+    uint16_t droppedSamples() const { return ring.droppedCount(); }
+
+    // slot 변환값이 below 미만으로 confirm번 연속이면 걸린다. 값이 rearm 이상으로
+    // 돌아와야 다시 걸린다 (한 번 떨어질 때 한 번만). begin() 뒤에 불러도 된다
+    void setWindow(uint8_t slot, uint16_t below, uint16_t rearm, uint8_t confirm);
+    void clearWindow();
+
+    // 창이 걸렸으면 true, 걸린 시각(micros)을 trippedAt에 넣고 표시를 지운다
+    bool takeWindowTrip(unsigned long& trippedAt);
+
+    // ADC ISR에서만 호출
+    void onConversionComplete(uint16_t value);
+
+private:
+    struct Channel {
+        uint8_t pin;
+        uint8_t mux;
+        uint16_t latest;
+        uint16_t average;
+        uint16_t blockSum;
+        uint8_t blockCount;
+        bool valid;             // 첫 블록 평균이 나왔는지
+        unsigned long samples;
+    };
+
+    void startConversion(uint8_t slot);
+    void checkWindow(uint16_t value);
+
+    static const uint8_t NO_WINDOW = 0xFF;
+
+    Channel channels[MAX_CHANNELS];
+    uint8_t channelCount;
+    volatile uint8_t currentSlot;
+    SpscRing<Sample, 64> ring;
+
+    // 창 비교 (ISR에서 갱신). 메인 루프는 인터럽트를 막고 바꾼다 (setWindow/clearWindow)
+    volatile uint8_t windowSlot;
+    uint16_t windowBelow;
+    uint16_t windowRearm;
+    uint8_t windowConfirm;
+    uint8_t windowCount;
+    bool windowArmed;
+    volatile bool windowTripped;
+    volatile unsigned long windowTrippedAt;
+#if !defined(__AVR__)
+    unsigned long lastDrainMicros;
+#endif
+};
+
+extern AdcSampler adcSampler;
+
+#endif
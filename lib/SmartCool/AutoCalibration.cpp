@@ -0,0 +1,66 @@
+#include "AutoCalibration.h"
+#include "ControlCore.h"
+#include "Hal.h"
+
+AutoCalibration autoCalibration;
+
+AutoCalibration::AutoCalibration() : rainQ(), waterQ(), active(false), lastSampleAt(0) {
+}
+
+void AutoCalibration::start() {
+    rainQ.reset();
+    waterQ.reset();
+    active = true;
+    lastSampleAt = hal::millis() - AUTOCAL_SAMPLE_MS;
+}
+
+void AutoCalibration::poll() {
+    if (!active || !sensors.isValid) return;
+    unsigned long now = hal::millis();
+    if (now - lastSampleAt < AUTOCAL_SAMPLE_MS) return;
+    lastSampleAt = now;
+    push((uint16_t)sensors.rainLevel, (uint16_t)sensors.waterLevelRaw);
+}
+
+void AutoCalibration::push(uint16_t rainRaw, uint16_t waterRaw) {
+    rainQ.push(rainRaw);
+    waterQ.push(waterRaw);
+}
+
+static AutoCalResult spanResult(const AutoCalQuantiles& q) {
+    if (q.samples() < AUTOCAL_MIN_SAMPLES) return AUTOCAL_FEW_SAMPLES;
+    if (q.high() < q.low() + AUTOCAL_MIN_SPAN) return AUTOCAL_NARROW;
+    return AUTOCAL_OK;
+}
+
+void AutoCalibration::propose(const CalibrationStore& store, AutoCalProposal& out) const {
+    out.rainResult = spanResult(rainQ);
+    out.rain = (int16_t)((rainQ.low() + rainQ.high()) / 2);
+    // 해제 경계(rain + 간격)가 ADC 범위를 넘지 않게
+    int16_t rainMax = (int16_t)(ADC_MAX - store.value(CAL_RAIN_HYSTERESIS));
+    if (out.rain > rainMax) out.rain = rainMax;
+
+    out.waterResult = spanResult(waterQ);
+    out.waterEmpty = (int16_t)waterQ.low();
+    out.waterFull = (int16_t)waterQ.high();
+
+    // 펌프 가능 수위는 예전 양 끝값 사이 같은 비율 자리로 (기본 600 = 62.5%)
+    int32_t oldEmpty = store.value(CAL_WATER_EMPTY);
+    int32_t oldSpan = store.value(CAL_WATER_FULL) - oldEmpty;
+    int32_t offset = store.value(CAL_WATER) - oldEmpty;
+    out.water = (int16_t)(out.waterEmpty + offset * (out.waterFull - out.waterEmpty) / oldSpan);
+    if (out.water < 0) out.water = 0;
+    if (out.water > (int16_t)ADC_MAX) out.water = ADC_MAX;
+}
+
+uint8_t AutoCalibration::loadProposal(const AutoCalProposal& proposal, CalibrationStore& store) {
+    uint8_t loaded = 0;
+    if (proposal.rainResult == AUTOCAL_OK && store.set(CAL_RAIN, proposal.rain) == CAL_OK) loaded++;
+    if (proposal.waterResult == AUTOCAL_OK) {
+        store.set(CAL_WATER_EMPTY, proposal.waterEmpty);
+        store.set(CAL_WATER_FULL, proposal.waterFull);
+        store.set(CAL_WATER, proposal.water);
+        loaded++;
+    }
+    return loaded;
+}
@@ -0,0 +1,84 @@
+/*
+ * SmartCool Parasol - 자동 보정 (빗물/수위 센서 양 끝값 추적)
+ *
+ * 수위 센서 양 끝값(기본 100/900)은 손으로 잰 값이라 전극이 부식되면 어긋난다.
+ * 자동 보정 세션 동안 빗물/수위 채널의 필터 값을 AUTOCAL_SAMPLE_MS마다 P² 추정기
+ * (Filters.h P2Quantiles)에 넣어 하위 5%/상위 95% 분위수를 샘플 저장 없이 따라간다.
+ * 채널당 30바이트, 샘플 하나에 비교/덧셈과 16비트 곱셈 5번 (마커 조정은 평균 샘플당 1번 안팎).
+ *
+ * propose()는 분위수에서 보정값을 제안한다.
+ *   수위: water_empty = 하위, water_full = 상위, water는 예전 양 끝값 사이 비율을 유지
+ *   빗물: rain = 젖음(하위)과 마름(상위)의 가운데
+ * 샘플이 AUTOCAL_MIN_SAMPLES보다 적거나 상하위 차가 AUTOCAL_MIN_SPAN보다 좁으면
+ * (세션 동안 탱크가 비고 차지 않았거나, 비가 오지 않았으면) 그 채널은 제안하지 않는다.
+ * 제안은 보정 편집본에 넣기만 하고, 적용은 다른 보정값과 같이 commit()(c save)으로 한다.
+ */
+
+#ifndef SMARTCOOL_AUTO_CALIBRATION_H
+#define SMARTCOOL_AUTO_CALIBRATION_H
+
+#include <stdint.h>
+#include "Calibration.h"
+#include "Filters.h"
+
+const uint16_t AUTOCAL_SAMPLE_MS = 2000;
+const uint16_t AUTOCAL_MIN_SAMPLES = 150;   // 5분
+const uint16_t AUTOCAL_MIN_SPAN = 200;      // 상위 - 하위 (ADC)
+
+// 하위 5% / 상위 95% (Q16)
+typedef P2Quantiles<3277, 62259> AutoCalQuantiles;
+
+enum AutoCalChannel : uint8_t {
+    AUTOCAL_RAIN,
+    AUTOCAL_WATER,
+    AUTOCAL_CHANNEL_COUNT
+};
+
+enum AutoCalResult : uint8_t {
+    AUTOCAL_OK,
+    AUTOCAL_FEW_SAMPLES,
+    AUTOCAL_NARROW
+};
+
+struct AutoCalProposal {
+    AutoCalResult rainResult;
+    AutoCalResult waterResult;
+    int16_t rain;
+    int16_t waterEmpty;
+    int16_t waterFull;
+    int16_t water;
+};
+
+class AutoCalibration {
+public:
+    AutoCalibration();
+
+    // 분위수를 비우고 샘플을 모으기 시작 (진행 중이면 처음부터)
+    void start();
+    void stop() { active = false; }
+    bool running() const { return active; }
+
+    // controlTick()에서. 진행 중이고 센서 값이 유효하면 AUTOCAL_SAMPLE_MS마다 한 샘플
+    void poll();
+
+    // 네이티브 테스트/시뮬레이터가 직접 넣을 때
+    void push(uint16_t rainRaw, uint16_t waterRaw);
+
+    const AutoCalQuantiles& quantiles(uint8_t channel) const { return channel == AUTOCAL_RAIN ? rainQ : waterQ; }
+
+    // 현재 분위수로 제안 (active는 지금 쓰는 보정값, water 비율 유지에 쓴다)
+    void propose(const CalibrationStore& store, AutoCalProposal& out) const;
+
+    // 제안된 채널만 편집본에 넣는다. 넣은 채널 수
+    static uint8_t loadProposal(const AutoCalProposal& proposal, CalibrationStore& store);
+
+private:
+    AutoCalQuantiles rainQ;
+    AutoCalQuantiles waterQ;
+    bool active;
+    unsigned long lastSampleAt;
+};
+
+extern AutoCalibration autoCalibration;
+
+#endif
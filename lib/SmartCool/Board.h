@@ -0,0 +1,55 @@
+/*
+ * SmartCool Parasol - 보드 프로필 (Arduino UNO)
+ *
+ * 핀 배치는 여기 한 곳에만 둔다. src/main.cpp, 네이티브 빌드, demo/, test/ 스케치가
+ * 모두 이 파일을 include 한다. 디지털 핀은 FastPin 타입으로 쓰면 SBI/CBI 한 명령이다.
+ *
+ *   RelayPin::output();
+ *   RelayPin::write(on);
+ *   StatusLed::toggle();
+ */
+
+#ifndef SMARTCOOL_BOARD_H
+#define SMARTCOOL_BOARD_H
+
+#include "FastGpio.h"
+#include "Hal.h"
+
+// 센서 레이어
+const uint8_t RAIN_SENSOR_PIN = A0;         // 빗물 감지 센서 (아날로그)
+const uint8_t TEMP_POTENTIOMETER_PIN = A1;  // 온도 시뮬레이션용 포텐셔미터
+const uint8_t WATER_LEVEL_PIN = A3;         // 물탱크 수위 센서 (아날로그)
+const uint8_t TEMP_SENSOR_PIN = A4;         // KY-013 아날로그 온도센서
+
+// 제어에 쓰는 온도 입력. 기본은 포텐셔미터 시뮬레이션,
+// -DTEMP_SOURCE_KY013=1 이면 실제 KY-013 NTC ([env:uno_release])
+#ifndef TEMP_SOURCE_KY013
+#define TEMP_SOURCE_KY013 0
+#endif
+const uint8_t TEMPERATURE_PIN = TEMP_SOURCE_KY013 ? TEMP_SENSOR_PIN : TEMP_POTENTIOMETER_PIN;
+
+// 온습도 (단선 프로토콜). 하강 에지를 INT0로 받으므로 핀 2 고정.
+// 기본은 DHT22, DHT11이면 -DDHT_TYPE=11
+#ifndef DHT_TYPE
+#define DHT_TYPE 22
+#endif
+const uint8_t DHT_PIN = 2;
+
+// 액추에이터 레이어
+const uint8_t RELAY_PIN = 6;                // 릴레이 모듈 제어 핀 (워터펌프)
+const uint8_t SERVO_PIN = 9;                // 파라솔 구동 서보모터 (OC1A)
+const uint8_t STATUS_LED_PIN = 13;          // 내장 LED (상태 표시)
+
+// 컴파일 타임 핀 타입
+typedef FastPin<RELAY_PIN> RelayPin;
+typedef FastPin<SERVO_PIN> ServoPin;
+typedef FastPin<STATUS_LED_PIN> StatusLed;
+typedef FastPin<DHT_PIN> DhtPin;
+
+typedef AnalogPin<RAIN_SENSOR_PIN> RainSensor;
+typedef AnalogPin<TEMP_POTENTIOMETER_PIN> TempPotentiometer;
+typedef AnalogPin<WATER_LEVEL_PIN> WaterLevelSensor;
+typedef AnalogPin<TEMP_SENSOR_PIN> TempSensor;
+typedef AnalogPin<TEMPERATURE_PIN> TemperatureInput;
+
+#endif
@@ -0,0 +1,185 @@
+#include "Calibration.h"
+#include "Hal.h"
+#include "Progmem.h"
+#include "Telemetry.h"
+
+struct CalibrationLimit {
+    int16_t defaultValue;
+    int16_t minValue;
+    int16_t maxValue;
+};
+
+// 기본값은 ControlCore.h의 컴파일 타임 상수 그대로
+static const CalibrationLimit LIMITS[CAL_KEY_COUNT] PROGMEM = {
+    { (int16_t)(HEAT_THRESHOLD * 10 + 0.5f), 100, 450 },
+    { (int16_t)((HEAT_THRESHOLD - HEAT_RELEASE) * 10 + 0.5f), 0, 50 },
+    { RAIN_THRESHOLD, 1, ADC_MAX },
+    { RAIN_RELEASE - RAIN_THRESHOLD, 0, 200 },
+    { WATER_THRESHOLD, 0, ADC_MAX },
+    { WATER_EMPTY_VALUE, 0, ADC_MAX - 1 },
+    { WATER_FULL_VALUE, 1, ADC_MAX },
+};
+
+const uint8_t KEY_NAME_MAX = 12;
+static const char KEY_NAMES[CAL_KEY_COUNT][KEY_NAME_MAX] PROGMEM = {
+    "heat", "heat_hyst", "rain", "rain_hyst", "water", "water_empty", "water_full"
+};
+
+// 슬롯: 버전, 순번, 값(리틀 엔디언), CRC16 (앞 16바이트)
+const uint8_t SLOT_CRC = 2 + sizeof(Calibration);
+
+CalibrationStore calibration;
+
+int16_t calibrationDefault(uint8_t key) { return (int16_t)pgm_read_word(&LIMITS[key].defaultValue); }
+int16_t calibrationMin(uint8_t key) { return (int16_t)pgm_read_word(&LIMITS[key].minValue); }
+int16_t calibrationMax(uint8_t key) { return (int16_t)pgm_read_word(&LIMITS[key].maxValue); }
+
+void calibrationDefaults(Calibration& cal) {
+    for (uint8_t i = 0; i < CAL_KEY_COUNT; i++) cal.values[i] = calibrationDefault(i);
+}
+
+bool calibrationKeyFromName(const char* name, uint8_t& key) {
+    for (uint8_t i = 0; i < CAL_KEY_COUNT; i++) {
+        uint8_t j = 0;
+        char c;
+        while ((c = (char)pgm_read_byte(&KEY_NAMES[i][j])) != 0 && name[j] == c) j++;
+        if (c == 0 && name[j] == 0) {
+            key = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+CalibrationResult validateCalibration(const Calibration& cal) {
+    for (uint8_t i = 0; i < CAL_KEY_COUNT; i++) {
+        if (cal.values[i] < calibrationMin(i) || cal.values[i] > calibrationMax(i)) return CAL_OUT_OF_RANGE;
+    }
+    if (cal.values[CAL_WATER_EMPTY] >= cal.values[CAL_WATER_FULL]) return CAL_WATER_ORDER;
+    if (cal.values[CAL_RAIN] + cal.values[CAL_RAIN_HYSTERESIS] > ADC_MAX) return CAL_RAIN_ORDER;
+    return CAL_OK;
+}
+
+void computeThresholds(const Calibration& cal, ControlThresholds& out) {
+    // 0.1°C → Q8.8 (280 → 7168, 기본값은 컴파일 타임 경계와 같은 원시값이 나온다)
+    int16_t heatQ = (int16_t)((int32_t)cal.values[CAL_HEAT] * Q_ONE / 10);
+    int16_t releaseQ = (int16_t)((int32_t)(cal.values[CAL_HEAT] - cal.values[CAL_HEAT_HYSTERESIS]) * Q_ONE / 10);
+    uint16_t heatRaw = temperatureRawForQ(heatQ);
+    uint16_t releaseRaw = temperatureRawForQ(releaseQ);
+    uint16_t rain = (uint16_t)cal.values[CAL_RAIN];
+    uint16_t rainRelease = (uint16_t)(cal.values[CAL_RAIN] + cal.values[CAL_RAIN_HYSTERESIS]);
+
+    for (uint8_t mode = 0; mode < MODE_COUNT; mode++) {
+        out.mode[mode].rainBelow = mode == MODE_RAIN ? rainRelease : rain;
+        out.mode[mode].heatAbove = mode == MODE_HEAT ? releaseRaw : heatRaw;
+        out.mode[mode].heatIndexAbove = mode == MODE_HEAT ? releaseQ : heatQ;
+    }
+    out.waterOK = (uint16_t)cal.values[CAL_WATER];
+    out.waterScale = makeLinearScale((uint16_t)cal.values[CAL_WATER_EMPTY],
+                                     (uint16_t)cal.values[CAL_WATER_FULL], 100 * Q_ONE);
+}
+
+static void applyCalibration(const Calibration& cal) {
+    ControlThresholds next;
+    computeThresholds(cal, next);
+    applyThresholds(next);
+}
+
+static uint16_t slotAddr(uint8_t slot) {
+    return EEPROM_CALIBRATION_ADDR + slot * EEPROM_CALIBRATION_SLOT_SIZE;
+}
+
+// CRC와 버전이 맞고 값도 유효하면 true
+static bool readSlot(uint8_t slot, Calibration& cal, uint8_t& sequence) {
+    uint8_t bytes[EEPROM_CALIBRATION_SLOT_SIZE];
+    for (uint8_t i = 0; i < sizeof(bytes); i++) bytes[i] = hal::eepromRead(slotAddr(slot) + i);
+
+    uint16_t crc = (uint16_t)(bytes[SLOT_CRC] | (bytes[SLOT_CRC + 1] << 8));
+    if (crc16Ccitt(bytes, SLOT_CRC) != crc || bytes[0] != CALIBRATION_VERSION) return false;
+
+    sequence = bytes[1];
+    for (uint8_t i = 0; i < CAL_KEY_COUNT; i++) {
+        cal.values[i] = (int16_t)(bytes[2 + 2 * i] | (bytes[3 + 2 * i] << 8));
+    }
+    return validateCalibration(cal) == CAL_OK;
+}
+
+CalibrationStore::CalibrationStore()
+    : active(), edit(), fromEeprom(false), activeSlot(1), activeSequence(0), targetSlot(0),
+      writeIndex(EEPROM_CALIBRATION_SLOT_SIZE) {
+    calibrationDefaults(active);
+    edit = active;
+}
+
+bool CalibrationStore::begin() {
+    Calibration slots[2];
+    uint8_t sequences[2];
+    bool valid[2];
+    for (uint8_t i = 0; i < 2; i++) valid[i] = readSlot(i, slots[i], sequences[i]);
+
+    // 둘 다 맞으면 순번이 더 새 것 (255 다음 0도 새 것)
+    uint8_t pick = valid[0] && valid[1] ? ((int8_t)(sequences[1] - sequences[0]) > 0 ? 1 : 0)
+                 : valid[1] ? 1 : 0;
+    fromEeprom = valid[pick];
+    if (fromEeprom) {
+        active = slots[pick];
+        activeSlot = pick;
+        activeSequence = sequences[pick];
+    } else {
+        calibrationDefaults(active);
+        activeSlot = 1;
+        activeSequence = 0;
+    }
+    edit = active;
+    writeIndex = EEPROM_CALIBRATION_SLOT_SIZE;
+    applyCalibration(active);
+    return fromEeprom;
+}
+
+CalibrationResult CalibrationStore::set(uint8_t key, int16_t value) {
+    if (key >= CAL_KEY_COUNT) return CAL_UNKNOWN_KEY;
+    if (value < calibrationMin(key) || value > calibrationMax(key)) return CAL_OUT_OF_RANGE;
+    edit.values[key] = value;
+    return CAL_OK;
+}
+
+CalibrationResult CalibrationStore::commit() {
+    CalibrationResult result = validateCalibration(edit);
+    if (result != CAL_OK) return result;
+
+    active = edit;
+    applyCalibration(active);
+
+    // 저장 중에 또 바꾸면 같은 (아직 안 맞는) 슬롯에 처음부터 다시 쓴다
+    if (!saving()) {
+        targetSlot = activeSlot ^ 1;
+        activeSequence++;
+    }
+    writeIndex = 0;
+    return CAL_OK;
+}
+
+void CalibrationStore::encodeSlot(uint8_t* bytes) const {
+    bytes[0] = CALIBRATION_VERSION;
+    bytes[1] = activeSequence;
+    for (uint8_t i = 0; i < CAL_KEY_COUNT; i++) {
+        bytes[2 + 2 * i] = (uint8_t)active.values[i];
+        bytes[3 + 2 * i] = (uint8_t)((uint16_t)active.values[i] >> 8);
+    }
+    uint16_t crc = crc16Ccitt(bytes, SLOT_CRC);
+    bytes[SLOT_CRC] = (uint8_t)crc;
+    bytes[SLOT_CRC + 1] = (uint8_t)(crc >> 8);
+}
+
+void CalibrationStore::poll() {
+    if (!saving() || !hal::eepromReady()) return;
+
+    // CRC가 마지막 두 바이트라 다 쓰기 전에는 새 슬롯이 유효하지 않다
+    uint8_t bytes[EEPROM_CALIBRATION_SLOT_SIZE];
+    encodeSlot(bytes);
+    hal::eepromWrite(slotAddr(targetSlot) + writeIndex, bytes[writeIndex]);
+    if (++writeIndex < EEPROM_CALIBRATION_SLOT_SIZE) return;
+
+    activeSlot = targetSlot;
+    fromEeprom = true;
+}
@@ -0,0 +1,99 @@
+/*
+ * SmartCool Parasol - 현장 보정값 (EEPROM, 시리얼로 조회/변경)
+ *
+ * 더위/비/수위 경계와 수위 센서 양 끝값을 다시 굽지 않고 현장에서 맞춘다.
+ * 값은 항목 번호(CalibrationKey)로 다루고, 단위는 온도 0.1°C, 나머지는 ADC 원시값.
+ *
+ *   set()    : 편집본만 바꾼다 (항목별 범위 검사)
+ *   commit() : 편집본 전체를 검사(수위 빈 < 가득 등)한 뒤 한 번에 적용하고 EEPROM에 저장
+ *
+ * 적용할 때 판정 경계(ControlThresholds)를 한 번 계산해 두므로 제어 주기에는 변환이 없다.
+ * EEPROM에는 같은 크기 슬롯 2개를 두고 번갈아 쓴다. 슬롯마다 버전, 순번, CRC16이 있고
+ * CRC를 맨 마지막에 쓰므로, 저장 중 전원이 나가면 새 슬롯은 깨진 채로 남고 이전 슬롯이
+ * 그대로 쓰인다. 부팅 때는 CRC가 맞는 슬롯 중 순번이 더 새 것을 읽는다 (둘 다 없으면 기본값).
+ * 저장은 poll()이 EEPROM이 준비될 때마다 한 바이트씩 (18바이트, 약 60ms) 해서 루프를 막지 않는다.
+ */
+
+#ifndef SMARTCOOL_CALIBRATION_H
+#define SMARTCOOL_CALIBRATION_H
+
+#include <stdint.h>
+#include "ControlCore.h"
+#include "EepromLayout.h"
+
+// 순서가 저장 순서이자 Messages.h MSG_CAL_* 선택지 순서. 새 항목은 끝에 붙이고 버전을 올린다
+enum CalibrationKey : uint8_t {
+    CAL_HEAT,               // 더위 진입 온도 (0.1°C, 체감 온도에도 같은 값)
+    CAL_HEAT_HYSTERESIS,    // 더위 해제 = 진입 - 이 값 (0.1°C)
+    CAL_RAIN,               // 빗물 센서가 이 값 미만이면 비
+    CAL_RAIN_HYSTERESIS,    // 비 해제 = 비 경계 + 이 값
+    CAL_WATER,              // 수위가 이 값 이상이면 펌프 가동 가능
+    CAL_WATER_EMPTY,        // 수위 0%
+    CAL_WATER_FULL,         // 수위 100%
+    CAL_KEY_COUNT
+};
+
+enum CalibrationResult : uint8_t {
+    CAL_OK,
+    CAL_UNKNOWN_KEY,
+    CAL_OUT_OF_RANGE,       // 항목 하나의 범위 (calibrationMin/Max)
+    CAL_WATER_ORDER,        // 수위 빈 값이 가득 값 이상
+    CAL_RAIN_ORDER          // 비 해제 경계(비 + 간격)가 ADC 범위를 넘음
+};
+
+const uint8_t CALIBRATION_VERSION = 1;
+
+struct Calibration {
+    int16_t values[CAL_KEY_COUNT];
+};
+
+static_assert(4 + sizeof(Calibration) <= EEPROM_CALIBRATION_SLOT_SIZE, "calibration does not fit its EEPROM slot");
+
+int16_t calibrationDefault(uint8_t key);
+int16_t calibrationMin(uint8_t key);
+int16_t calibrationMax(uint8_t key);
+void calibrationDefaults(Calibration& cal);
+
+// 항목 이름("heat", "water_full" ...) → 번호. 모르는 이름이면 false
+bool calibrationKeyFromName(const char* name, uint8_t& key);
+
+// 항목 사이 관계 검사 / 판정 경계 계산
+CalibrationResult validateCalibration(const Calibration& cal);
+void computeThresholds(const Calibration& cal, ControlThresholds& out);
+
+class CalibrationStore {
+public:
+    CalibrationStore();
+
+    // EEPROM에서 읽어 적용 (없거나 깨졌으면 기본값). controlBegin()에서. 읽었으면 true
+    bool begin();
+
+    // 저장 중이면 EEPROM이 준비될 때마다 한 바이트
+    void poll();
+
+    CalibrationResult set(uint8_t key, int16_t value);
+    CalibrationResult commit();
+    void revert() { edit = active; }
+    void loadDefaults() { calibrationDefaults(edit); }
+
+    int16_t value(uint8_t key) const { return active.values[key]; }
+    int16_t edited(uint8_t key) const { return edit.values[key]; }
+    bool stored() const { return fromEeprom; }
+    bool saving() const { return writeIndex < EEPROM_CALIBRATION_SLOT_SIZE; }
+    uint8_t sequence() const { return activeSequence; }
+
+private:
+    void encodeSlot(uint8_t* bytes) const;
+
+    Calibration active;
+    Calibration edit;
+    bool fromEeprom;
+    uint8_t activeSlot;         // 마지막으로 다 쓴(또는 읽은) 슬롯
+    uint8_t activeSequence;
+    uint8_t targetSlot;         // 저장 중인 슬롯
+    uint8_t writeIndex;         // 저장 중인 바이트 (슬롯 크기면 저장 중 아님)
+};
+
+extern CalibrationStore calibration;
+
+#endif
@@ -0,0 +1,445 @@
+#include "ControlCore.h"
+#include "Actuators.h"
+#include "AdcSampler.h"
+#include "AutoCalibration.h"
+#include "Calibration.h"
+#include "Dht.h"
+#include "Filters.h"
+#include "Hal.h"
+#include "Journal.h"
+#include "ModeTable.h"
+#include "Profiler.h"
+
+SensorData sensors;
+SystemStatus status;
+
+bool rainDetected = false;  // 현재 비가 오는지
+bool heatDetected = false;  // 현재 더위인지
+
+static ControlHooks controlHooks = { 0, 0, 0 };
+
+static unsigned long modeEnteredAt = 0;
+static bool transitionPending = false;
+static bool actuatorsHeld = false;      // 자가 진단이 구동 중 (대기 모드에서만 유효)
+
+// ============= 모드 전이 테이블 (컴파일 타임 생성, 플래시 저장) =============
+constexpr uint8_t edgeDwell(uint8_t from, uint8_t to) {
+    return to == MODE_RAIN ? 0
+         : from == MODE_RAIN ? DWELL_RAIN_EXIT
+         : from == MODE_HEAT ? DWELL_HEAT_EXIT
+         : DWELL_HEAT_ENTER;
+}
+
+constexpr ModeEdge modeEdge(uint8_t from, uint8_t code) {
+    return makeEdge(from, desiredMode(code, MODE_STANDBY, MODE_RAIN, MODE_HEAT),
+                    edgeDwell(from, desiredMode(code, MODE_STANDBY, MODE_RAIN, MODE_HEAT)));
+}
+
+constexpr ModeRow modeRow(uint8_t mode) {
+    return ModeRow{
+        { modeEdge(mode, 0), modeEdge(mode, 1), modeEdge(mode, 2), modeEdge(mode, 3) }
+    };
+}
+
+// 기본 경계 (EEPROM 보정값을 읽기 전, 또는 보정값이 없을 때)
+constexpr ModeBounds defaultBounds(uint8_t mode) {
+    return ModeBounds{
+        (uint16_t)(mode == MODE_RAIN ? RAIN_RELEASE : RAIN_THRESHOLD),
+        (uint16_t)(mode == MODE_HEAT ? HEAT_RELEASE_RAW : HEAT_THRESHOLD_RAW),
+        (int16_t)(mode == MODE_HEAT ? HEAT_INDEX_RELEASE_Q : HEAT_INDEX_THRESHOLD_Q)
+    };
+}
+
+static const ModeRow MODE_TABLE[MODE_COUNT] PROGMEM = {
+    modeRow(MODE_STANDBY),
+    modeRow(MODE_RAIN),
+    modeRow(MODE_HEAT),
+};
+
+ControlThresholds thresholds = {
+    { defaultBounds(MODE_STANDBY), defaultBounds(MODE_RAIN), defaultBounds(MODE_HEAT) },
+    WATER_THRESHOLD,
+    WATER_SCALE
+};
+
+static const uint8_t ADC_PINS[ADC_SLOT_COUNT] = {
+    RAIN_SENSOR_PIN, TEMPERATURE_PIN, WATER_LEVEL_PIN
+};
+
+// 채널 주기마다 ADC 블록 평균을 한 샘플씩 넣는다
+static SlidingMedian<uint16_t, 3> rainFilter;           // 60ms 창, 한 번 튀는 값 제거
+static Kalman1D<uint16_t, 4, 16> temperatureFilter;     // 0.5초 안팎으로 수렴, 잡음만 제거
+static MovingAverage<uint16_t, 4, uint16_t> waterFilter;    // 1초 창, 수면 출렁임 평균
+
+static uint16_t filterRain(uint16_t raw) { return rainFilter.push(raw); }
+static uint16_t filterTemperature(uint16_t raw) { return temperatureFilter.push(raw); }
+static uint16_t filterWater(uint16_t raw) { return waterFilter.push(raw); }
+
+static bool readAdcSlot(uint8_t slot, uint16_t& raw) {
+    if (!adcSampler.ready(slot)) return false;
+    raw = adcSampler.average(slot);
+    return true;
+}
+
+// 비는 빠르게, 수위는 느리게. 신선도 마감은 주기의 몇 배로 여유를 둔다
+static SensorChannel sensorChannels[SENSOR_COUNT] = {
+    SENSOR_CHANNEL(ADC_RAIN,  filterRain,        20,  200),
+    SENSOR_CHANNEL(ADC_TEMP,  filterTemperature, 100, 1000),
+    SENSOR_CHANNEL(ADC_WATER, filterWater,       250, 2000),
+};
+
+SensorRegistry sensorRegistry(sensorChannels, SENSOR_COUNT, hal::millis, readAdcSlot);
+RainOnsetStats rainOnsetStats;
+
+static bool humidityUpdated = false;    // DHT 새 측정값이 아직 반영되지 않음
+
+static void senseTask();
+static void modeTask();
+static void actuateTask();
+static void motionTask();
+static void reportTask();
+
+static Task tasks[TASK_COUNT] = {
+    SCHEDULER_TASK(senseTask,   20,    10),     // 센서 레지스트리 (가장 빠른 채널 주기)
+    SCHEDULER_TASK(modeTask,    100,   10),     // 모드 판단
+    SCHEDULER_TASK(actuateTask, 100,   10),     // 파라솔/펌프 구동
+    SCHEDULER_TASK(motionTask,  MOTION_TICK_MS, 5), // 서보 램프
+    SCHEDULER_TASK(reportTask,  10000, 1000),   // 상태 출력 (10초마다)
+};
+
+Scheduler scheduler(tasks, TASK_COUNT, hal::millis);
+ServoMotion parasolMotion(PARASOL_MAX_SPEED, PARASOL_ACCELERATION, MOTION_TICK_MS);
+ActuatorCache actuators(parasolMotion);
+
+void initializeSystem() {
+    status.parasolDeployed = false;
+    status.pumpActive = false;
+    status.systemReady = false;
+    status.lastUpdate = hal::millis();
+    status.operationMode = MODE_STANDBY;
+    modeEnteredAt = hal::millis();
+    transitionPending = false;
+    actuatorsHeld = false;
+
+    sensors.temperature = Celsius::fromQ(0);
+    sensors.temperatureRaw = 0;
+    sensors.rainLevel = 0;
+    sensors.waterLevelRaw = 0;
+    sensors.waterLevelPercent = Percent::fromQ(0);
+    sensors.waterLevelOK = false;
+    sensors.humidity = Percent::fromQ(0);
+    sensors.heatIndex = Celsius::fromQ(0);
+    sensors.humidityValid = false;
+    sensors.staleMask = (1 << SENSOR_COUNT) - 1;
+    sensors.isValid = false;
+
+    rainDetected = false;
+    heatDetected = false;
+}
+
+void initializePins() {
+    RelayPin::output();
+    relayOFF();
+}
+
+void initializeActuators() {
+    hal::servoAttach(SERVO_PIN);
+    actuators.invalidate();
+    actuators.writeServo(ANGLE_STOWED);
+    parasolMotion.reset(ANGLE_STOWED);
+    actuators.commandParasol(ANGLE_STOWED);
+    relayOFF();
+}
+
+void relayOFF() {
+    actuators.commandRelay(false);
+    status.pumpActive = false;
+}
+
+void relayON() {
+    actuators.commandRelay(true);
+    status.pumpActive = true;
+}
+
+Percent calculateWaterPercent(int rawValue) {
+    return waterLevelToPercent(rawValue, thresholds.waterScale);
+}
+
+// 포텐셔미터(시뮬레이션) 또는 KY-013
+static void applyTemperature(int raw) {
+    sensors.temperatureRaw = raw;
+    sensors.temperature = temperatureToCelsius(raw);
+}
+
+static void applyRain(int raw) {
+    sensors.rainLevel = raw;
+}
+
+static void applyWater(int raw) {
+    sensors.waterLevelRaw = raw;
+    sensors.waterLevelPercent = calculateWaterPercent(raw);
+    sensors.waterLevelOK = (raw >= thresholds.waterOK);
+}
+
+// 체감 온도는 온도나 습도가 바뀔 때만 다시 계산 (표 조회 2번 + 곱셈)
+static void applyHumidity(bool valid) {
+    sensors.humidityValid = valid;
+    if (valid) sensors.humidity = dht.humidity();
+    sensors.heatIndex = valid ? apparentTemperature(sensors.temperature, sensors.humidity)
+                              : sensors.temperature;
+}
+
+void updateSensorData(int temperatureRaw, int rainRaw, int waterRaw) {
+    applyTemperature(temperatureRaw);
+    applyRain(rainRaw);
+    applyWater(waterRaw);
+    applyHumidity(dht.fresh(HUMIDITY_STALE_MS));
+    sensors.staleMask = 0;
+    sensors.isValid = true;
+}
+
+void readAllSensors() {
+    // 주기가 된 채널만 ADC 블록 평균을 필터에 넣고 결과를 반영한다 (블로킹 없음)
+    uint8_t updated = sensorRegistry.poll();
+    if (updated & (1 << SENSOR_RAIN)) applyRain(sensorRegistry.value(SENSOR_RAIN));
+    if (updated & (1 << SENSOR_TEMP)) applyTemperature(sensorRegistry.value(SENSOR_TEMP));
+    if (updated & (1 << SENSOR_WATER)) applyWater(sensorRegistry.value(SENSOR_WATER));
+
+    // 습도는 DHT가 자기 주기로 갱신한다. 끊겨도 모드 판단은 멈추지 않고 온도만으로
+    bool humid = dht.fresh(HUMIDITY_STALE_MS);
+    if ((updated & (1 << SENSOR_TEMP)) || humidityUpdated || humid != sensors.humidityValid) {
+        humidityUpdated = false;
+        applyHumidity(humid);
+    }
+
+    // 한 채널이라도 값이 끊기면 모드 판단을 멈춘다 (마지막 모드 유지)
+    sensors.staleMask = sensorRegistry.staleMask();
+    sensors.isValid = (sensors.staleMask == 0);
+}
+
+bool updateSystemMode() {
+    if (!status.systemReady || !sensors.isValid) return false;
+
+    // 현재 모드의 경계값으로 비/더위 판정 (히스테리시스).
+    // 더위는 습도가 있으면 체감 온도, 없으면 온도 원시값으로
+    const ModeBounds& bounds = thresholds.mode[status.operationMode];
+    rainDetected = sensors.rainLevel < (int)bounds.rainBelow;
+    heatDetected = sensors.humidityValid
+        ? sensors.heatIndex.q > bounds.heatIndexAbove
+        : sensors.temperatureRaw > (int)bounds.heatAbove;
+
+    const ModeRow* row = &MODE_TABLE[status.operationMode];
+    uint8_t code = (rainDetected ? INPUT_RAIN : 0) | (heatDetected ? INPUT_HEAT : 0);
+    const ModeEdge* edge = &row->edges[code];
+    uint8_t newMode = pgm_read_byte(&edge->next);
+
+    transitionPending = (newMode != status.operationMode);
+    if (!transitionPending) return false;
+
+    // 최소 유지 시간이 지나야 전이
+    unsigned long now = hal::millis();
+    unsigned long dwellMs = pgm_read_byte(&edge->dwellSec) * 1000UL;
+    if (now - modeEnteredAt < dwellMs) return false;
+
+    status.operationMode = newMode;
+    modeEnteredAt = now;
+    transitionPending = false;
+    return true;
+}
+
+bool modeTransitionPending() {
+    return transitionPending;
+}
+
+void holdActuators(bool hold) {
+    actuatorsHeld = hold;
+}
+
+void applyThresholds(const ControlThresholds& next) {
+    thresholds = next;
+    adcSampler.setWindow(ADC_RAIN, thresholds.mode[MODE_STANDBY].rainBelow,
+                         thresholds.mode[MODE_RAIN].rainBelow, RAIN_ONSET_CONFIRM);
+
+    // 수위 판정은 다음 샘플을 기다리지 않고 바로 (%, 펌프 가능 여부)
+    if (sensors.isValid) applyWater(sensors.waterLevelRaw);
+}
+
+void controlParasol() {
+    if (actuatorsHeld && status.operationMode == MODE_STANDBY) return;
+
+    // 목표 각도만 명령하고, 실제 이동은 motionTask가 램프로 처리한다.
+    // 같은 각도의 반복 명령은 액추에이터 캐시에서 걸러진다
+    switch (status.operationMode) {
+    case MODE_STANDBY: // 수납
+        actuators.commandParasol(ANGLE_STOWED);
+        status.parasolDeployed = false;
+        break;
+
+    case MODE_RAIN: // 빗물 수집 각도
+        actuators.commandParasol(ANGLE_COLLECT);
+        status.parasolDeployed = true;
+        break;
+
+    case MODE_HEAT: // 차양 각도
+        actuators.commandParasol(ANGLE_SHADE);
+        status.parasolDeployed = true;
+        break;
+    }
+}
+
+PumpEvent controlWaterPump() {
+    if (actuatorsHeld && status.operationMode == MODE_STANDBY) return PUMP_NO_CHANGE;
+
+    bool shouldPumpRun = (status.operationMode == MODE_HEAT) && sensors.waterLevelOK;
+
+    if (shouldPumpRun && !status.pumpActive) {
+        relayON();
+        return PUMP_STARTED;
+    } else if (!shouldPumpRun && status.pumpActive) {
+        relayOFF();
+        if (status.operationMode == MODE_HEAT && !sensors.waterLevelOK) {
+            return PUMP_STOPPED_LOW_WATER;
+        }
+        return PUMP_STOPPED;
+    }
+    return PUMP_NO_CHANGE;
+}
+
+void fillTelemetry(TelemetryRecord& record) {
+    record.uptimeMs = hal::millis();
+    record.temperatureQ = sensors.temperature.q;
+    record.temperatureRaw = (uint16_t)sensors.temperatureRaw;
+    record.rainLevel = (uint16_t)sensors.rainLevel;
+    record.waterLevelRaw = (uint16_t)sensors.waterLevelRaw;
+    record.waterPercentQ = sensors.waterLevelPercent.q;
+    record.flags = (sensors.isValid ? TFLAG_SENSORS_VALID : 0)
+                 | (sensors.waterLevelOK ? TFLAG_WATER_OK : 0)
+                 | (status.parasolDeployed ? TFLAG_PARASOL_DEPLOYED : 0)
+                 | (status.pumpActive ? TFLAG_PUMP_ACTIVE : 0)
+                 | (status.systemReady ? TFLAG_SYSTEM_READY : 0)
+                 | (rainDetected ? TFLAG_RAIN_DETECTED : 0)
+                 | (heatDetected ? TFLAG_HEAT_DETECTED : 0)
+                 | (sensors.humidityValid ? TFLAG_HUMIDITY_VALID : 0);
+    record.operationMode = (uint8_t)status.operationMode;
+    record.lastUpdate = status.lastUpdate;
+    record.humidityQ = sensors.humidity.q;
+    record.heatIndexQ = sensors.heatIndex.q;
+}
+
+// ============= 태스크 =============
+static void senseTask() {
+    int rainBelow = thresholds.mode[MODE_STANDBY].rainBelow;
+    bool wasRaining = (sensors.rainLevel < rainBelow);
+    {
+        PROFILE_SCOPE(STAGE_SENSE);
+        readAllSensors();
+    }
+
+    // 비 상태가 바뀌면 다음 주기를 기다리지 않고 바로 모드 판단
+    if (sensors.isValid && wasRaining != (sensors.rainLevel < rainBelow)) {
+        scheduler.trigger(TASK_MODE);
+    }
+}
+
+static void modeTask() {
+    bool changed;
+    {
+        PROFILE_SCOPE(STAGE_MODE);
+        changed = updateSystemMode();
+    }
+    if (changed) {
+        journal.record(JOURNAL_MODE, (uint8_t)status.operationMode);
+        if (controlHooks.modeChanged) controlHooks.modeChanged(status.operationMode);
+        scheduler.trigger(TASK_ACTUATE);
+    }
+}
+
+static void actuateTask() {
+    {
+        PROFILE_SCOPE(STAGE_PARASOL);
+        controlParasol();
+    }
+    PumpEvent event;
+    {
+        PROFILE_SCOPE(STAGE_PUMP);
+        event = controlWaterPump();
+    }
+    switch (event) {
+    case PUMP_STARTED: journal.record(JOURNAL_PUMP_ON); break;
+    case PUMP_STOPPED: journal.record(JOURNAL_PUMP_OFF, 0); break;
+    case PUMP_STOPPED_LOW_WATER: journal.record(JOURNAL_PUMP_OFF, 1); break;
+    default: break;
+    }
+    if (event != PUMP_NO_CHANGE && controlHooks.pumpEvent) {
+        controlHooks.pumpEvent(event);
+    }
+}
+
+static void motionTask() {
+    if (parasolMotion.update()) {
+        actuators.writeServo(parasolMotion.angle());
+    } else {
+        // 멈춰 있으면 펄스를 끊어 서보 유지 전류와 Timer1을 쉬게 한다
+        actuators.releaseIdleServo(SERVO_IDLE_DETACH_MS);
+    }
+}
+
+static void reportTask() {
+    if (controlHooks.report) {
+        PROFILE_SCOPE(STAGE_REPORT);
+        controlHooks.report();
+    }
+    status.lastUpdate = hal::millis();
+}
+
+// 비 시작 빠른 경로. ISR 창 비교가 걸리면 필터/센싱 주기/모드 태스크를 건너뛰고
+// 바로 비 모드로 바꿔 구동한다. 비 모드 진입은 유지 시간 0이라 모드 표와 같은 전이고,
+// 필터 값이 따라오면 senseTask가 그대로 이어받는다
+static void rainOnsetFastPath() {
+    unsigned long trippedAt;
+    if (!adcSampler.takeWindowTrip(trippedAt)) return;
+    if (rainOnsetStats.trips < 0xFFFF) rainOnsetStats.trips++;
+    if (!status.systemReady || status.operationMode == MODE_RAIN) return;
+
+    rainDetected = true;
+    status.operationMode = MODE_RAIN;
+    modeEnteredAt = hal::millis();
+    transitionPending = false;
+    journal.record(JOURNAL_MODE, MODE_RAIN);
+    actuateTask();
+
+    unsigned long elapsed = hal::micros() - trippedAt;
+    uint16_t latency = elapsed > 0xFFFF ? 0xFFFF : (uint16_t)elapsed;
+    rainOnsetStats.lastMicros = latency;
+    if (latency > rainOnsetStats.maxMicros) rainOnsetStats.maxMicros = latency;
+    if (rainOnsetStats.preemptions < 0xFFFF) rainOnsetStats.preemptions++;
+
+    if (controlHooks.modeChanged) controlHooks.modeChanged(status.operationMode);
+}
+
+void controlBegin(const ControlHooks& hooks) {
+    controlHooks = hooks;
+    rainFilter.reset();
+    temperatureFilter.reset();
+    waterFilter.reset();
+    sensorRegistry.begin();
+    adcSampler.begin(ADC_PINS, ADC_SLOT_COUNT);
+    calibration.begin();    // 보정값 → applyThresholds (비 시작 창 비교 포함)
+    rainOnsetStats = RainOnsetStats();
+    dht.begin();
+    humidityUpdated = false;
+    journal.begin();
+    scheduler.begin();
+}
+
+bool controlTick() {
+    // ISR이 쌓아둔 ADC 샘플을 비우고, 블로킹 없이 준비된 태스크만 실행
+    PROFILE_LOOP_TICK();
+    adcSampler.drain();
+    rainOnsetFastPath();
+    if (dht.poll()) humidityUpdated = true;
+    journal.poll();
+    calibration.poll();
+    autoCalibration.poll();
+    return scheduler.runOnce();
+}
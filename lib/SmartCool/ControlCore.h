@@ -0,0 +1,209 @@
+/*
+ * SmartCool Parasol - 제어 코어
+ *
+ * 센서 변환, 모드 판단, 파라솔/펌프 제어와 태스크 스케줄을 담당한다.
+ * 하드웨어는 HAL로만 접근하므로 [env:uno]와 [env:native] 양쪽에서 그대로 돈다.
+ * 시리얼 출력 같은 표시 기능은 ControlHooks로 애플리케이션에 넘긴다.
+ */
+
+#ifndef SMARTCOOL_CONTROL_CORE_H
+#define SMARTCOOL_CONTROL_CORE_H
+
+#include <stdint.h>
+#include "Board.h"
+#include "ModeTable.h"
+#include "Scheduler.h"
+#include "SensorConversion.h"
+#include "SensorRegistry.h"
+#include "ServoMotion.h"
+#include "Telemetry.h"
+
+// ============= 상태 구조체 =============
+struct SensorData {
+    Celsius temperature;        // Q8.8
+    int temperatureRaw;
+    int rainLevel;
+    int waterLevelRaw;
+    Percent waterLevelPercent;  // Q8.8
+    bool waterLevelOK;
+    Percent humidity;           // Q8.8, DHT (humidityValid일 때만 의미 있음)
+    Celsius heatIndex;          // 체감 온도 Q8.8. 습도가 없으면 temperature와 같다
+    bool humidityValid;         // DHT 값이 HUMIDITY_STALE_MS 안에 들어옴
+    bool isValid;               // 모든 채널이 신선도 마감 안에 갱신됨
+    uint8_t staleMask;          // 값이 없거나 마감을 넘긴 채널 (1 << SensorId)
+};
+
+struct SystemStatus {
+    bool parasolDeployed;
+    bool pumpActive;
+    bool systemReady;
+    unsigned long lastUpdate;
+    int operationMode; // 0: 대기, 1: 비모드, 2: 더위모드
+};
+
+enum OperationMode {
+    MODE_STANDBY = 0,
+    MODE_RAIN = 1,
+    MODE_HEAT = 2,
+    MODE_COUNT
+};
+
+enum PumpEvent {
+    PUMP_NO_CHANGE,
+    PUMP_STARTED,
+    PUMP_STOPPED,
+    PUMP_STOPPED_LOW_WATER
+};
+
+extern SensorData sensors;
+extern SystemStatus status;
+extern bool rainDetected;
+extern bool heatDetected;
+
+// ============= 온도 입력 변환 (Board.h TEMP_SOURCE_KY013) =============
+#if TEMP_SOURCE_KY013
+inline Celsius temperatureToCelsius(uint16_t raw) { return ky013ToCelsius(raw); }
+constexpr uint16_t temperatureRawForCelsius(float c) { return ky013RawForCelsius(c); }
+inline uint16_t temperatureRawForQ(int16_t q) { return ky013RawForQ(q); }
+#else
+inline Celsius temperatureToCelsius(uint16_t raw) { return potentiometerToCelsius(raw); }
+constexpr uint16_t temperatureRawForCelsius(float c) { return potRawForCelsius(c); }
+inline uint16_t temperatureRawForQ(int16_t q) { return potRawForQ(q); }
+#endif
+
+// ============= 임계값 기본값 (비교는 모두 ADC 원시값으로) =============
+// 현장에서는 EEPROM 보정값(Calibration.h)이 이 값을 대신한다
+constexpr float HEAT_THRESHOLD = 28.0;  // 컴파일 타임에만 사용
+constexpr int HEAT_THRESHOLD_RAW = temperatureRawForCelsius(HEAT_THRESHOLD);
+const int RAIN_THRESHOLD = 500;
+const int WATER_THRESHOLD = 600;
+
+// 히스테리시스: 모드를 빠져나올 때의 경계
+const int RAIN_RELEASE = RAIN_THRESHOLD + 50;           // 비 모드 해제는 550 이상
+constexpr float HEAT_RELEASE = HEAT_THRESHOLD - 0.5;    // 더위 해제는 27.5°C 이하
+constexpr int HEAT_RELEASE_RAW = temperatureRawForCelsius(HEAT_RELEASE);
+
+// 습도가 있으면 같은 경계를 체감 온도(Q8.8)에 적용한다. 습한 날은 더 낮은 기온에서,
+// 건조한 날은 더 높은 기온에서 더위 모드가 된다
+constexpr int16_t HEAT_INDEX_THRESHOLD_Q = (int16_t)(HEAT_THRESHOLD * Q_ONE);
+constexpr int16_t HEAT_INDEX_RELEASE_Q = (int16_t)(HEAT_RELEASE * Q_ONE);
+
+// DHT 측정(2초)이 이만큼 끊기면 습도 없이 온도만으로 판단
+const uint16_t HUMIDITY_STALE_MS = 6000;
+
+// 비 시작 빠른 경로: ADC ISR에서 빗물 센서 변환값이 RAIN_THRESHOLD 아래로
+// 이만큼 연속이면(변환 간격 약 0.3ms) 태스크 주기를 기다리지 않고 비 모드로 선점
+const uint8_t RAIN_ONSET_CONFIRM = 8;
+
+// 최소 유지 시간 (초). 비 모드 진입은 항상 즉시
+const uint8_t DWELL_RAIN_EXIT = 60;     // 비가 잠깐 그쳐도 1분은 수집 유지
+const uint8_t DWELL_HEAT_EXIT = 30;
+const uint8_t DWELL_HEAT_ENTER = 10;    // 대기 모드에서 10초는 지나야 다시 더위 모드
+
+// 수위 센서 기본 설정값 (보정 가능)
+const int WATER_EMPTY_VALUE = 100;
+const int WATER_FULL_VALUE = 900;
+constexpr LinearScale WATER_SCALE =
+    makeLinearScale(WATER_EMPTY_VALUE, WATER_FULL_VALUE, 100 * Q_ONE);
+
+// 파라솔 각도
+const uint8_t ANGLE_STOWED = 30;     // 수납
+const uint8_t ANGLE_SHADE = 80;      // 차양 (더위 모드)
+const uint8_t ANGLE_COLLECT = 130;   // 빗물 수집 (비 모드)
+
+// 파라솔 모션 프로파일 (30→130도 약 1.6초)
+const uint16_t PARASOL_MAX_SPEED = 90;      // 도/초
+const uint16_t PARASOL_ACCELERATION = 180;  // 도/초²
+const uint8_t MOTION_TICK_MS = 10;
+
+// 램프가 끝나고 이만큼 지나면 서보 펄스를 끊는다 (서보가 실제로 도착할 여유)
+const uint16_t SERVO_IDLE_DETACH_MS = 1000;
+
+// ============= 태스크 =============
+// 순서가 태스크 ID. 비 감지 → 모드 판단 → 구동은 trigger()로 즉시 연결된다.
+enum TaskId {
+    TASK_SENSE,
+    TASK_MODE,
+    TASK_ACTUATE,
+    TASK_MOTION,
+    TASK_REPORT,
+    TASK_COUNT
+};
+
+extern Scheduler scheduler;
+extern ServoMotion parasolMotion;
+
+// ADC 샘플러 슬롯 (ISR이 이 순서로 라운드로빈 변환)
+enum AdcSlot {
+    ADC_RAIN,
+    ADC_TEMP,
+    ADC_WATER,
+    ADC_SLOT_COUNT
+};
+
+// 센서 채널 (레지스트리 테이블 순서). 주기/필터/신선도 마감은 ControlCore.cpp
+enum SensorId {
+    SENSOR_RAIN,        // 20ms, 중앙값 3
+    SENSOR_TEMP,        // 100ms, 칼만
+    SENSOR_WATER,       // 250ms, 이동 평균 4
+    SENSOR_COUNT
+};
+
+extern SensorRegistry sensorRegistry;
+
+// 비 시작 빠른 경로 통계. 지연은 ISR 창 비교가 걸린 시각 → 파라솔 명령까지
+struct RainOnsetStats {
+    uint16_t trips;             // 창 비교가 걸린 횟수
+    uint16_t preemptions;       // 실제로 모드를 선점한 횟수 (이미 비 모드/부팅 중이면 생략)
+    uint16_t lastMicros;
+    uint16_t maxMicros;
+};
+
+extern RainOnsetStats rainOnsetStats;
+
+// 보정값에서 한 번 계산해 둔 판정 경계. 매 주기 변환하지 않는다 (applyThresholds)
+struct ControlThresholds {
+    ModeBounds mode[MODE_COUNT];    // 모드별 비/더위 경계 (히스테리시스 포함)
+    uint16_t waterOK;               // 수위 원시값이 이 이상이면 펌프 가동 가능
+    LinearScale waterScale;         // 수위 원시값 → %
+};
+
+extern ControlThresholds thresholds;
+
+// 애플리케이션 훅 (필요 없는 항목은 NULL)
+struct ControlHooks {
+    void (*modeChanged)(int mode);
+    void (*pumpEvent)(PumpEvent event);
+    void (*report)();
+};
+
+// ============= 함수 =============
+void initializeSystem();
+void initializePins();
+void initializeActuators();
+void relayON();
+void relayOFF();
+
+Percent calculateWaterPercent(int rawValue);
+void updateSensorData(int temperatureRaw, int rainRaw, int waterRaw);
+void readAllSensors();
+bool updateSystemMode();        // 모드가 바뀌면 true
+bool modeTransitionPending();   // 전이 조건은 됐지만 최소 유지 시간 대기 중
+void controlParasol();
+PumpEvent controlWaterPump();
+
+// 자가 진단이 대기 모드에서 파라솔/펌프를 직접 구동하는 동안 제어 명령을 멈춘다.
+// 대기 모드를 벗어나면 hold와 상관없이 제어가 바로 다시 구동한다
+void holdActuators(bool hold);
+
+// 새 판정 경계를 한 번에 바꾸고 비 시작 창 비교도 다시 맞춘다 (controlBegin 뒤에도 가능)
+void applyThresholds(const ControlThresholds& next);
+
+// 현재 sensors/status를 텔레메트리 레코드로 (type, sequence는 호출 측이 채운다)
+void fillTelemetry(TelemetryRecord& record);
+
+// ADC 샘플링과 스케줄러 시작 / 메인 루프에서 반복 호출 (태스크를 실행했으면 true)
+void controlBegin(const ControlHooks& hooks);
+bool controlTick();
+
+#endif
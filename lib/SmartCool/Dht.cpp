@@ -0,0 +1,155 @@
+#include "Dht.h"
+#include "Board.h"
+#include "Hal.h"
+
+#if defined(__AVR__)
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#endif
+
+static_assert(DHT_PIN == 2, "DhtSensor listens on INT0, the DHT data line must stay on pin 2");
+
+// 측정 간격은 센서 사양 최소값 (DHT11 1초, DHT22 2초)
+static const uint16_t READ_PERIOD_MS_11 = 1000;
+static const uint16_t READ_PERIOD_MS_22 = 2000;
+static const uint16_t FIRST_READ_MS = 1000;     // 전원 인가 후 안정 시간
+
+// 시작 신호 LOW 유지: DHT11 18ms 이상, DHT22 1ms 이상 (millis 한 칸을 넘겨야 보장)
+static const uint8_t START_MS_11 = 18;
+static const uint8_t START_MS_22 = 1;
+
+DhtSensor dht(DHT_TYPE == 11 ? DHT_MODEL_11 : DHT_MODEL_22);
+
+DhtSensor::DhtSensor(DhtModel sensorModel)
+    : model(sensorModel), state(STATE_IDLE), stateAt(0), lastStart(0), readAt(0),
+      hasReading(false), temp(Celsius::fromQ(0)), rh(Percent::fromQ(0)), counters(),
+      edges(0), lastEdgeMicros(0), frame() {
+}
+
+void DhtSensor::begin() {
+    finish();
+    DhtPin::inputPullup();
+    hasReading = false;
+    counters = DhtStats();
+    uint16_t period = model == DHT_MODEL_11 ? READ_PERIOD_MS_11 : READ_PERIOD_MS_22;
+    lastStart = hal::millis() - period + FIRST_READ_MS;
+}
+
+bool DhtSensor::fresh(unsigned long maxAgeMs) const {
+    return hasReading && hal::millis() - readAt <= maxAgeMs;
+}
+
+bool DhtSensor::poll() {
+    unsigned long now = hal::millis();
+    switch (state) {
+    case STATE_IDLE:
+        if (now - lastStart >= (model == DHT_MODEL_11 ? READ_PERIOD_MS_11 : READ_PERIOD_MS_22)) {
+            startSignal(now);
+        }
+        return false;
+
+    case STATE_START:
+        if (now - stateAt > (model == DHT_MODEL_11 ? START_MS_11 : START_MS_22)) release(now);
+        return false;
+
+    case STATE_RECEIVE:
+        break;
+    }
+
+    if (edges < DHT_FRAME_EDGES) {
+        if (now - stateAt > DHT_RESPONSE_TIMEOUT_MS) {
+            finish();
+            if (counters.timeouts < 0xFFFF) counters.timeouts++;
+        }
+        return false;
+    }
+
+    // 42번째 에지 뒤로는 ISR이 프레임을 건드리지 않는다
+    finish();
+    uint8_t bytes[DHT_FRAME_BYTES];
+    for (uint8_t i = 0; i < DHT_FRAME_BYTES; i++) bytes[i] = frame[i];
+
+    Celsius t;
+    Percent h;
+    if (!decode(bytes, model, t, h)) {
+        if (counters.checksumErrors < 0xFFFF) counters.checksumErrors++;
+        return false;
+    }
+    temp = t;
+    rh = h;
+    readAt = now;
+    hasReading = true;
+    if (counters.reads < 0xFFFF) counters.reads++;
+    return true;
+}
+
+void DhtSensor::startSignal(unsigned long now) {
+    DhtPin::low();
+    DhtPin::output();
+    state = STATE_START;
+    stateAt = now;
+    lastStart = now;
+}
+
+void DhtSensor::release(unsigned long now) {
+    edges = 0;
+    for (uint8_t i = 0; i < DHT_FRAME_BYTES; i++) frame[i] = 0;
+    lastEdgeMicros = hal::micros();
+
+    // 선을 놓으면 풀업으로 올라가고, 센서가 20~40us 뒤 LOW로 응답한다 (에지 0)
+    DhtPin::inputPullup();
+#if defined(__AVR__)
+    EICRA = (uint8_t)((EICRA & ~(_BV(ISC01) | _BV(ISC00))) | _BV(ISC01));    // 하강 에지
+    EIFR = _BV(INTF0);
+    EIMSK |= _BV(INT0);
+#endif
+    state = STATE_RECEIVE;
+    stateAt = now;
+}
+
+void DhtSensor::finish() {
+#if defined(__AVR__)
+    EIMSK &= (uint8_t)~_BV(INT0);
+#endif
+    state = STATE_IDLE;
+}
+
+// ISR 안에서 에지 하나마다. 간격 비교와 비트 세우기만 한다
+void DhtSensor::onFallingEdge(unsigned long nowMicros) {
+    uint8_t n = edges;
+    if (n >= DHT_FRAME_EDGES) return;
+    if (n >= 2 && nowMicros - lastEdgeMicros > DHT_ONE_THRESHOLD_MICROS) {
+        uint8_t bit = n - 2;
+        frame[bit >> 3] |= (uint8_t)(0x80 >> (bit & 7));
+    }
+    lastEdgeMicros = nowMicros;
+    edges = n + 1;
+}
+
+bool DhtSensor::decode(const uint8_t* bytes, DhtModel type, Celsius& t, Percent& h) {
+    if ((uint8_t)(bytes[0] + bytes[1] + bytes[2] + bytes[3]) != bytes[4]) return false;
+
+    // 둘 다 0.1 단위로 맞춘다. DHT11은 정수/소수 바이트, DHT22는 16비트 ×10 (부호 비트)
+    int16_t tTenths;
+    uint16_t hTenths;
+    if (type == DHT_MODEL_11) {
+        hTenths = (uint16_t)(bytes[0] * 10 + bytes[1] % 10);
+        tTenths = (int16_t)(bytes[2] * 10 + (bytes[3] & 0x7F) % 10);
+        if (bytes[3] & 0x80) tTenths = -tTenths;
+    } else {
+        hTenths = (uint16_t)((bytes[0] << 8) | bytes[1]);
+        tTenths = (int16_t)(((bytes[2] & 0x7F) << 8) | bytes[3]);
+        if (bytes[2] & 0x80) tTenths = -tTenths;
+    }
+    if (hTenths > 1000 || tTenths < -400 || tTenths > 800) return false;
+
+    t = Celsius::fromQ((int16_t)((int32_t)tTenths * Q_ONE / 10));
+    h = Percent::fromQ((uint16_t)((uint32_t)hTenths * Q_ONE / 10));
+    return true;
+}
+
+#if defined(__AVR__)
+ISR(INT0_vect) {
+    dht.onFallingEdge(hal::micros());
+}
+#endif
@@ -0,0 +1,94 @@
+/*
+ * SmartCool Parasol - 논블로킹 DHT11/DHT22 온습도 드라이버 (핀 2 = INT0)
+ *
+ * DHT 라이브러리는 40비트 프레임을 받는 약 5ms(시작 신호 포함 최대 20ms) 동안
+ * 인터럽트를 끄고 펄스 폭을 바쁜 대기로 잰다. 그동안 ADC 샘플러, UART 수신이 멈춘다.
+ *
+ * 여기서는 시작 신호(LOW 유지)를 poll() 상태 기계가 millis()로 재고, 응답은
+ * INT0 하강 에지 ISR이 micros() 시각만 찍어 비트를 쌓는다. 비트 값은 하강 에지 간격
+ * (LOW 50us + HIGH 26~28us 또는 70us)으로 정한다: 0 ≈ 78us, 1 ≈ 120us.
+ *
+ *   에지 0: 센서 응답 LOW 시작, 에지 1: 첫 비트 LOW 시작,
+ *   에지 k+2: 비트 k 끝 (k = 0..39) → 프레임 하나에 하강 에지 42개
+ *
+ * Timer1 입력 캡처(ICP1 = 핀 8)는 ICR1이 서보 PWM 주기(TOP)라 쓸 수 없다.
+ * micros() 해상도 4us면 0/1 간격 차이(40us 이상)를 가르기에 충분하다.
+ */
+
+#ifndef SMARTCOOL_DHT_H
+#define SMARTCOOL_DHT_H
+
+#include <stdint.h>
+#include "FixedPoint.h"
+
+enum DhtModel : uint8_t {
+    DHT_MODEL_11,
+    DHT_MODEL_22
+};
+
+const uint8_t DHT_FRAME_BYTES = 5;
+const uint8_t DHT_FRAME_EDGES = 2 + DHT_FRAME_BYTES * 8;
+const uint8_t DHT_ONE_THRESHOLD_MICROS = 100;   // 하강 에지 간격이 이보다 길면 1
+const uint8_t DHT_RESPONSE_TIMEOUT_MS = 10;     // 응답 80+80us + 40비트 최대 약 5ms
+
+struct DhtStats {
+    uint16_t reads;             // 체크섬까지 맞은 프레임
+    uint16_t checksumErrors;
+    uint16_t timeouts;          // 에지가 모자란 채로 시간 초과 (센서 없음 포함)
+};
+
+class DhtSensor {
+public:
+    explicit DhtSensor(DhtModel sensorModel);
+
+    // 데이터 핀을 풀업 입력으로 두고 첫 측정을 예약 (센서 전원 안정 1초 뒤)
+    void begin();
+
+    // 메인 루프에서 매번 호출. 시작 신호 → 수신 → 해석을 블로킹 없이 진행하고
+    // 새 측정값이 나오면 true
+    bool poll();
+
+    bool valid() const { return hasReading; }
+    unsigned long updatedAt() const { return readAt; }
+    bool fresh(unsigned long maxAgeMs) const;
+    bool receiving() const { return state == STATE_RECEIVE; }
+
+    Celsius temperature() const { return temp; }
+    Percent humidity() const { return rh; }
+    const DhtStats& stats() const { return counters; }
+
+    // INT0 ISR에서 하강 에지마다 (네이티브 테스트는 가짜 에지를 직접 넣는다)
+    void onFallingEdge(unsigned long nowMicros);
+
+    // 40비트 프레임 해석. 체크섬이 틀리거나 값이 범위 밖이면 false
+    static bool decode(const uint8_t* bytes, DhtModel type, Celsius& t, Percent& h);
+
+private:
+    enum State : uint8_t {
+        STATE_IDLE,
+        STATE_START,        // 데이터 선을 LOW로 누르고 있는 중
+        STATE_RECEIVE       // 선을 놓고 에지를 받는 중
+    };
+
+    void startSignal(unsigned long now);
+    void release(unsigned long now);
+    void finish();
+
+    DhtModel model;
+    State state;
+    unsigned long stateAt;
+    unsigned long lastStart;
+    unsigned long readAt;
+    bool hasReading;
+    Celsius temp;
+    Percent rh;
+    DhtStats counters;
+
+    volatile uint8_t edges;
+    volatile unsigned long lastEdgeMicros;
+    volatile uint8_t frame[DHT_FRAME_BYTES];
+};
+
+extern DhtSensor dht;
+
+#endif
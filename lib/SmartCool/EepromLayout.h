@@ -0,0 +1,32 @@
+/*
+ * SmartCool Parasol - EEPROM 배치 (ATmega328P 1KB)
+ *
+ * 영역마다 시작 주소와 크기를 여기 한 곳에 둔다. 새 영역은 뒤에 붙이고,
+ * 아래 static_assert로 겹침/초과를 컴파일 때 막는다.
+ * 각 영역은 자기 레코드 안에 버전과 CRC를 두므로 지운 칩(0xFF)이나
+ * 옛 펌웨어가 쓴 값은 그냥 "없음"으로 읽힌다.
+ */
+
+#ifndef SMARTCOOL_EEPROM_LAYOUT_H
+#define SMARTCOOL_EEPROM_LAYOUT_H
+
+#include <stdint.h>
+#include "Hal.h"
+
+// 자가 진단 결과 캐시 (SelfTest.h)
+const uint16_t EEPROM_SELF_TEST_ADDR = 0;
+const uint16_t EEPROM_SELF_TEST_SIZE = 8;
+
+// 이벤트 기록 원형 버퍼 (Journal.h). 4바이트 슬롯 192개
+const uint16_t EEPROM_JOURNAL_ADDR = EEPROM_SELF_TEST_ADDR + EEPROM_SELF_TEST_SIZE;
+const uint16_t EEPROM_JOURNAL_SIZE = 768;
+
+// 현장 보정값 (Calibration.h). 같은 크기 슬롯 2개를 번갈아 쓴다
+const uint16_t EEPROM_CALIBRATION_ADDR = EEPROM_JOURNAL_ADDR + EEPROM_JOURNAL_SIZE;
+const uint16_t EEPROM_CALIBRATION_SLOT_SIZE = 18;
+const uint16_t EEPROM_CALIBRATION_SIZE = 2 * EEPROM_CALIBRATION_SLOT_SIZE;
+
+const uint16_t EEPROM_USED_END = EEPROM_CALIBRATION_ADDR + EEPROM_CALIBRATION_SIZE;
+static_assert(EEPROM_USED_END <= hal::EEPROM_SIZE, "EEPROM layout exceeds 1KB");
+
+#endif
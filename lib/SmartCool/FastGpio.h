@@ -0,0 +1,116 @@
+/*
+ * SmartCool Parasol - 컴파일 타임 핀 고정 GPIO (ATmega328P / Arduino UNO)
+ *
+ *   typedef FastPin<RELAY_PIN> RelayPin;     // Board.h
+ *   RelayPin::output();
+ *   RelayPin::high();                        // sbi PORTD, 6  (2클럭)
+ *
+ * 핀 번호가 템플릿 인자라 포트와 비트가 컴파일 타임에 정해지고, 상수 I/O 주소의
+ * 한 비트 쓰기는 SBI/CBI 한 명령이 된다. digitalWrite()의 핀 표 조회(플래시 3번),
+ * PWM 타이머 끄기 확인, SREG 저장/복원(50클럭 이상)이 모두 없다.
+ * PORTB/C/D는 SBI/CBI가 닿는 I/O 주소라 ISR이 같은 포트의 다른 비트를 써도 안전하다.
+ *
+ * 네이티브 빌드에서는 hal::digitalWrite()/digitalRead()로 넘겨 가상 핀에 남긴다.
+ */
+
+#ifndef SMARTCOOL_FAST_GPIO_H
+#define SMARTCOOL_FAST_GPIO_H
+
+#include <stdint.h>
+#include "Hal.h"
+
+#if defined(__AVR__)
+#include <avr/io.h>
+#endif
+
+// UNO 핀 번호 → 포트: D0~D7 = PORTD, D8~D13 = PORTB, A0~A5(14~19) = PORTC
+enum GpioPort : uint8_t { GPIO_PORT_B, GPIO_PORT_C, GPIO_PORT_D };
+
+constexpr GpioPort gpioPort(uint8_t pin) {
+    return pin < 8 ? GPIO_PORT_D : pin < 14 ? GPIO_PORT_B : GPIO_PORT_C;
+}
+
+constexpr uint8_t gpioBit(uint8_t pin) {
+    return pin < 8 ? pin : pin < 14 ? pin - 8 : pin - 14;
+}
+
+template <uint8_t Pin>
+struct FastPin {
+    static_assert(Pin < 20, "UNO has digital pins D0-D13 and A0-A5 (14-19)");
+
+    static const uint8_t pin = Pin;
+    static const GpioPort port = gpioPort(Pin);
+    static const uint8_t mask = (uint8_t)(1 << gpioBit(Pin));
+
+#if defined(__AVR__)
+    // port가 상수라 분기는 컴파일 때 사라지고 명령 하나만 남는다
+    static void high() {
+        if (port == GPIO_PORT_B) PORTB |= mask;
+        else if (port == GPIO_PORT_C) PORTC |= mask;
+        else PORTD |= mask;
+    }
+
+    static void low() {
+        if (port == GPIO_PORT_B) PORTB &= (uint8_t)~mask;
+        else if (port == GPIO_PORT_C) PORTC &= (uint8_t)~mask;
+        else PORTD &= (uint8_t)~mask;
+    }
+
+    // PINx 비트에 1을 쓰면 출력이 뒤집힌다 (읽기-수정-쓰기 없음)
+    static void toggle() {
+        if (port == GPIO_PORT_B) PINB = mask;
+        else if (port == GPIO_PORT_C) PINC = mask;
+        else PIND = mask;
+    }
+
+    static bool read() {
+        return (port == GPIO_PORT_B ? PINB : port == GPIO_PORT_C ? PINC : PIND) & mask;
+    }
+
+    static void output() {
+        if (port == GPIO_PORT_B) DDRB |= mask;
+        else if (port == GPIO_PORT_C) DDRC |= mask;
+        else DDRD |= mask;
+    }
+
+    static void input() {
+        if (port == GPIO_PORT_B) DDRB &= (uint8_t)~mask;
+        else if (port == GPIO_PORT_C) DDRC &= (uint8_t)~mask;
+        else DDRD &= (uint8_t)~mask;
+        low();      // 풀업 끔
+    }
+
+    static void inputPullup() {
+        if (port == GPIO_PORT_B) DDRB &= (uint8_t)~mask;
+        else if (port == GPIO_PORT_C) DDRC &= (uint8_t)~mask;
+        else DDRD &= (uint8_t)~mask;
+        high();
+    }
+#else
+    static void high() { hal::digitalWrite(Pin, HIGH); }
+    static void low() { hal::digitalWrite(Pin, LOW); }
+    static void toggle() { hal::digitalWrite(Pin, hal::digitalRead(Pin) ? LOW : HIGH); }
+    static bool read() { return hal::digitalRead(Pin) == HIGH; }
+    static void output() { hal::pinMode(Pin, OUTPUT); }
+    static void input() { hal::pinMode(Pin, INPUT); }
+    static void inputPullup() { hal::pinMode(Pin, INPUT_PULLUP); }
+#endif
+
+    static void write(bool level) {
+        if (level) high();
+        else low();
+    }
+};
+
+// 아날로그 입력 핀. ADC 채널 번호(MUX)가 컴파일 타임 상수
+template <uint8_t Pin>
+struct AnalogPin {
+    static_assert(Pin >= 14 && Pin < 20, "analog inputs are A0-A5 (14-19)");
+
+    static const uint8_t pin = Pin;
+    static const uint8_t channel = Pin - 14;
+
+    static uint16_t read() { return hal::analogRead(Pin); }
+};
+
+#endif
@@ -0,0 +1,290 @@
+/*
+ * SmartCool Parasol - 샘플 단위 증분 필터 (정수 전용, 동적 할당 없음)
+ *
+ * 샘플이 들어올 때마다 push()로 한 번 갱신하고, value()는 언제든 바로 읽는다.
+ * 값을 얻으려고 ADC를 다시 여러 번 읽거나 기다리지 않는다.
+ * 창 크기와 정수 타입은 템플릿 인자라 컴파일 타임에 정해지고 메모리도 고정이다.
+ *
+ *   MovingAverage<uint16_t, 16>   누적합 링 버퍼 평균. push O(1)
+ *   SlidingMedian<uint16_t, 5>    정렬된 창 유지 중앙값. push 최대 2N 이동, value O(1)
+ *   Kalman1D<uint16_t, 1, 16>     스칼라 칼만 (프로세스/측정 분산). push O(1), 나눗셈 1회
+ *   P2Quantiles<3277, 62259>      P² 하위/상위 분위수 추정 (5% / 95%). 마커 7개, 28바이트
+ *
+ * 첫 샘플부터 value()가 유효하다. 창이 덜 찬 동안은 들어온 샘플만으로 계산한다.
+ */
+
+#ifndef SMARTCOOL_FILTERS_H
+#define SMARTCOOL_FILTERS_H
+
+#include <stdint.h>
+
+// ============= 이동 평균 =============
+// Acc: 누적합 타입. N x 샘플 최대값이 들어가야 한다 (10비트 ADC x 64 = 16비트 충분)
+template <typename T, uint8_t N, typename Acc = int32_t>
+class MovingAverage {
+    static_assert(N >= 1, "window must not be empty");
+
+public:
+    MovingAverage() { reset(); }
+
+    void reset() {
+        sum = 0;
+        index = 0;
+        count = 0;
+    }
+
+    T push(T sample) {
+        if (count == N) {
+            sum -= window[index];
+        } else {
+            count++;
+        }
+        window[index] = sample;
+        sum += sample;
+        if (++index == N) index = 0;
+        return value();
+    }
+
+    // 창이 차면 상수 N으로 나눈다 (N이 2의 거듭제곱이면 시프트)
+    T value() const {
+        if (count == N) return (T)(sum / N);
+        return count ? (T)(sum / count) : 0;
+    }
+
+    bool full() const { return count == N; }
+    uint8_t size() const { return count; }
+
+private:
+    T window[N];
+    Acc sum;
+    uint8_t index;
+    uint8_t count;
+};
+
+// ============= 이동 중앙값 =============
+// 튀는 샘플(빗방울 튐, 접점 노이즈)을 평균처럼 끌려가지 않고 버린다.
+// 도착 순서 링과 정렬된 창을 함께 두고, 가장 오래된 값을 빼고 새 값을 끼운다
+template <typename T, uint8_t N>
+class SlidingMedian {
+    static_assert(N >= 1 && (N & 1) == 1, "median window must be odd");
+    static_assert(N <= 15, "median window is kept sorted by insertion, keep it small");
+
+public:
+    SlidingMedian() { reset(); }
+
+    void reset() {
+        index = 0;
+        count = 0;
+    }
+
+    T push(T sample) {
+        if (count == N) remove(window[index]);
+        insert(sample);
+        window[index] = sample;
+        if (++index == N) index = 0;
+        return value();
+    }
+
+    // 창이 덜 찼을 때 짝수 개면 낮은 쪽 중앙값
+    T value() const { return count ? sorted[(count - 1) >> 1] : 0; }
+
+    bool full() const { return count == N; }
+    uint8_t size() const { return count; }
+
+private:
+    void remove(T old) {
+        uint8_t i = 0;
+        while (i < count && sorted[i] != old) i++;
+        for (; i + 1 < count; i++) sorted[i] = sorted[i + 1];
+        count--;
+    }
+
+    void insert(T sample) {
+        uint8_t i = count;
+        while (i > 0 && sorted[i - 1] > sample) {
+            sorted[i] = sorted[i - 1];
+            i--;
+        }
+        sorted[i] = sample;
+        count++;
+    }
+
+    T window[N];
+    T sorted[N];
+    uint8_t index;
+    uint8_t count;
+};
+
+// ============= 1차원 칼만 =============
+// 상태 = 측정값 자체(천천히 변하는 온도 등). Q: 샘플당 프로세스 분산, R: 측정 분산
+// (둘 다 raw² 단위). Q/R이 작을수록 부드럽고 느리다. 정상 상태 이득은 대략 sqrt(Q/R).
+// 상태는 Q6 고정소수점, 분산과 이득은 Q8. 16비트 샘플 전 범위에서 32비트로 넘치지 않는다
+template <typename T, uint16_t Q, uint16_t R>
+class Kalman1D {
+    static_assert(sizeof(T) <= 2, "Kalman1D works on 8/16-bit samples");
+    static_assert(R >= 1 && R <= 4095 && Q <= 4095, "variance out of fixed-point range");
+
+public:
+    Kalman1D() { reset(); }
+
+    void reset() {
+        x = 0;
+        p = 0;
+        started = false;
+    }
+
+    T push(T sample) {
+        int32_t z = (int32_t)sample << STATE_SHIFT;
+        if (!started) {
+            // 첫 샘플을 그대로 믿고, 불확실성은 측정 분산만큼
+            x = z;
+            p = (uint32_t)R << 8;
+            started = true;
+            return sample;
+        }
+
+        p += (uint32_t)Q << 8;
+        uint32_t k = (p << 8) / (p + ((uint32_t)R << 8));   // 0..256
+        x += ((int32_t)k * (z - x)) >> 8;
+        p -= (k * p) >> 8;
+        return value();
+    }
+
+    T value() const { return (T)((x + (1 << (STATE_SHIFT - 1))) >> STATE_SHIFT); }
+
+    // 현재 칼만 이득 (Q8, 256 = 측정값을 그대로 따름)
+    uint16_t gain() const {
+        uint32_t predicted = p + ((uint32_t)Q << 8);
+        return (uint16_t)((predicted << 8) / (predicted + ((uint32_t)R << 8)));
+    }
+
+private:
+    static const uint8_t STATE_SHIFT = 6;
+
+    int32_t x;      // 추정값 (Q6)
+    uint32_t p;     // 추정 분산 (raw² Q8)
+    bool started;
+};
+
+// ============= P² 분위수 (하위/상위 한 쌍) =============
+// Jain & Chlamtac의 P² 알고리즘을 두 분위수로 넓힌 것 (마커 2m+3 = 7개).
+// 샘플을 저장하지 않고 마커 높이 7개와 위치 7개만 갱신한다. 마커 0/6은 최소/최대,
+// 2/4가 하위/상위 분위수, 1/3/5는 그 사이 중간 지점이다.
+// Low/High: 분위수 비율 Q16 (3277 = 5%). 높이는 ADC 값 Q5 (int16), 위치는 uint16이라
+// 65535 샘플에서 멈춘다 (2초 간격이면 약 36시간).
+// push: 칸 찾기 비교 최대 7번 + 위치 증가 + 목표 위치 곱셈 5번. 목표에서 1 이상 벗어난
+// 마커만 포물선(나눗셈 4번, 벗어나면 직선 1번) 보간으로 한 칸 옮긴다
+template <uint16_t Low, uint16_t High>
+class P2Quantiles {
+    static_assert(Low > 0 && Low < High, "quantiles must satisfy 0 < Low < High < 1");
+
+public:
+    static const uint8_t MARKERS = 7;
+
+    P2Quantiles() { reset(); }
+
+    void reset() { count = 0; }
+
+    // sample: 10비트 ADC 값 (0..1023)
+    void push(uint16_t sample) {
+        if (count == 0xFFFF) return;
+        int16_t x = (int16_t)(sample << HEIGHT_SHIFT);
+
+        // 처음 7개는 정렬해서 그대로 마커로
+        if (count < MARKERS) {
+            uint8_t i = (uint8_t)count;
+            while (i > 0 && height[i - 1] > x) {
+                height[i] = height[i - 1];
+                i--;
+            }
+            height[i] = x;
+            if (++count == MARKERS) {
+                for (uint8_t m = 0; m < MARKERS; m++) position[m] = m + 1;
+            }
+            return;
+        }
+
+        // x가 들어가는 칸 k (height[k] <= x < height[k + 1]), 양 끝은 최소/최대 갱신
+        uint8_t k;
+        if (x < height[0]) {
+            height[0] = x;
+            k = 0;
+        } else if (x >= height[MARKERS - 1]) {
+            height[MARKERS - 1] = x;
+            k = MARKERS - 2;
+        } else {
+            k = 0;
+            while (x >= height[k + 1]) k++;
+        }
+        for (uint8_t m = k + 1; m < MARKERS; m++) position[m]++;
+        count++;
+
+        for (uint8_t m = 1; m < MARKERS - 1; m++) {
+            // 목표 위치 1 + (count - 1) × 비율 (Q16)
+            uint32_t desired = (uint32_t)(count - 1) * fraction(m) + 0x10000UL;
+            int32_t d = (int32_t)(desired - ((uint32_t)position[m] << 16));
+            if (d >= 0x10000L && position[m + 1] - position[m] > 1) {
+                adjust(m, 1);
+            } else if (d <= -0x10000L && position[m - 1] - position[m] < -1) {
+                adjust(m, -1);
+            }
+        }
+    }
+
+    // 7개가 모이기 전에는 모인 샘플에서 가장 가까운 순위
+    uint16_t low() const { return marker(2, Low); }
+    uint16_t high() const { return marker(4, High); }
+    uint16_t minimum() const { return count ? toSample(height[0]) : 0; }
+    uint16_t maximum() const { return count ? toSample(height[count < MARKERS ? count - 1 : MARKERS - 1]) : 0; }
+    uint16_t samples() const { return count; }
+    bool full() const { return count == 0xFFFF; }
+
+private:
+    static const uint8_t HEIGHT_SHIFT = 5;
+
+    // 마커별 분위수 비율 (Q16). 0과 6은 쓰지 않는다
+    static constexpr uint16_t fraction(uint8_t m) {
+        return m == 1 ? Low / 2
+             : m == 2 ? Low
+             : m == 3 ? (uint16_t)(((uint32_t)Low + High) / 2)
+             : m == 4 ? High
+             : (uint16_t)((0x10000UL + High) / 2);
+    }
+
+    static uint16_t toSample(int16_t h) { return (uint16_t)((h + (1 << (HEIGHT_SHIFT - 1))) >> HEIGHT_SHIFT); }
+
+    uint16_t marker(uint8_t m, uint16_t q) const {
+        if (count == 0) return 0;
+        if (count < MARKERS) return toSample(height[((uint32_t)(count - 1) * q + 0x8000UL) >> 16]);
+        return toSample(height[m]);
+    }
+
+    void adjust(uint8_t m, int8_t s) {
+        int32_t n0 = position[m - 1];
+        int32_t n1 = position[m];
+        int32_t n2 = position[m + 1];
+        int32_t q0 = height[m - 1];
+        int32_t q1 = height[m];
+        int32_t q2 = height[m + 1];
+
+        // 포물선 예측. 두 항을 따로 나눠 32비트 안에서 계산한다 (높이 차 × 위치 차 < 2^31)
+        int32_t a = (n1 - n0 + s) * (q2 - q1) / (n2 - n1);
+        int32_t b = (n2 - n1 - s) * (q1 - q0) / (n1 - n0);
+        int32_t qp = q1 + s * (a / (n2 - n0) + b / (n2 - n0));
+        if (q0 < qp && qp < q2) {
+            height[m] = (int16_t)qp;
+        } else {
+            // 이웃을 넘으면 직선
+            int32_t qs = s > 0 ? q2 : q0;
+            int32_t ns = s > 0 ? n2 : n0;
+            height[m] = (int16_t)(q1 + s * (qs - q1) / (ns - n1));
+        }
+        position[m] += s;
+    }
+
+    int16_t height[MARKERS];
+    uint16_t position[MARKERS];
+    uint16_t count;
+};
+
+#endif
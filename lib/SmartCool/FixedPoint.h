@@ -0,0 +1,37 @@
+/*
+ * SmartCool Parasol - 고정소수점(Q8.8) 센서 값 타입
+ *
+ * ATmega328P에는 FPU가 없어 float 연산은 소프트웨어 루틴으로 처리된다.
+ * 센서 값은 모두 정수 ×256 (Q8.8) 형태로 다루고, 출력할 때만 0.1 단위로 바꾼다.
+ */
+
+#ifndef SMARTCOOL_FIXED_POINT_H
+#define SMARTCOOL_FIXED_POINT_H
+
+#include <stdint.h>
+
+const uint8_t Q_SHIFT = 8;
+const int16_t Q_ONE = 1 << Q_SHIFT;
+
+// Q8.8 값을 0.1 단위 정수로 (반올림)
+inline int16_t qToTenths(int16_t q) {
+    return (int16_t)(((int32_t)q * 10 + (Q_ONE / 2)) >> Q_SHIFT);
+}
+
+// 온도 (°C × 256)
+struct Celsius {
+    int16_t q;
+
+    static Celsius fromQ(int16_t q) { Celsius c = { q }; return c; }
+    int16_t tenths() const { return qToTenths(q); }
+};
+
+// 백분율 (% × 256), 0 ~ 100%
+struct Percent {
+    uint16_t q;
+
+    static Percent fromQ(uint16_t q) { Percent p = { q }; return p; }
+    int16_t tenths() const { return qToTenths((int16_t)q); }
+};
+
+#endif
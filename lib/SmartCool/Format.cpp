@@ -0,0 +1,11 @@
+#include "Format.h"
+
+const char* formatCopyLiteral(LogLine& line, const char* formatP) {
+    char c;
+    while ((c = (char)pgm_read_byte(formatP)) != 0) {
+        if (c == '{' && (char)pgm_read_byte(formatP + 1) == '}') return formatP + 2;
+        line.append(c);
+        formatP++;
+    }
+    return formatP;
+}
@@ -0,0 +1,74 @@
+/*
+ * SmartCool Parasol - 형식 문자열 출력 (동적 할당 없음)
+ *
+ *   LOGF_INFO("   온도: {}°C (Raw: {})", tenths(t), raw);
+ *
+ * 형식 문자열은 PSTR로 플래시에만 두고, {} 자리에 인자를 순서대로 넣는다.
+ * 인자를 어떻게 찍을지는 타입(LogLine::append 오버로드)이 정하므로 %d/%s 같은
+ * 지정자가 없고 타입이 어긋날 일도 없다. {} 개수와 인자 개수가 다르면 컴파일 오류.
+ * 결과는 스택의 LogLine 하나에 모여 로거(TX 링)로 바로 간다. String/힙은 쓰지 않는다.
+ */
+
+#ifndef SMARTCOOL_FORMAT_H
+#define SMARTCOOL_FORMAT_H
+
+#include "Log.h"
+
+// 컴파일 타임: 형식 문자열 리터럴의 {} 개수
+constexpr unsigned formatPlaceholders(const char* format) {
+    return *format == 0 ? 0
+         : (format[0] == '{' && format[1] == '}') ? 1 + formatPlaceholders(format + 2)
+         : formatPlaceholders(format + 1);
+}
+
+// 플래시 형식 문자열을 다음 {} 앞까지 line에 복사하고 {} 뒤를 반환 (없으면 끝)
+const char* formatCopyLiteral(LogLine& line, const char* formatP);
+
+inline void formatAppend(LogLine& line, const char* formatP) {
+    formatCopyLiteral(line, formatP);
+}
+
+template <typename T, typename... Rest>
+inline void formatAppend(LogLine& line, const char* formatP, T first, Rest... rest) {
+    formatP = formatCopyLiteral(line, formatP);
+    line.append(first);
+    formatAppend(line, formatP, rest...);
+}
+
+// N: 형식 문자열의 {} 개수 (LOGF_* 매크로가 리터럴에서 계산해 넘긴다)
+template <unsigned N, typename... Args>
+inline bool logFormat(const char* formatP, Args... args) {
+    static_assert(N == sizeof...(Args), "format string {} count does not match argument count");
+    LogLine line;
+    formatAppend(line, formatP, args...);
+    return line.commit();
+}
+
+#define LOG_FORMAT(format, ...) \
+    logFormat<formatPlaceholders(format)>(PSTR(format), ##__VA_ARGS__)
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOGF_ERROR(format, ...) LOG_FORMAT(format, ##__VA_ARGS__)
+#else
+#define LOGF_ERROR(format, ...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOGF_WARN(format, ...) LOG_FORMAT(format, ##__VA_ARGS__)
+#else
+#define LOGF_WARN(format, ...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOGF_INFO(format, ...) LOG_FORMAT(format, ##__VA_ARGS__)
+#else
+#define LOGF_INFO(format, ...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOGF_DEBUG(format, ...) LOG_FORMAT(format, ##__VA_ARGS__)
+#else
+#define LOGF_DEBUG(format, ...) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,62 @@
+/*
+ * SmartCool Parasol - 하드웨어 추상화 계층(HAL)
+ *
+ * 제어 로직은 Arduino API 대신 hal:: 함수만 사용한다.
+ * - [env:uno]    : HalArduino.cpp 가 Arduino/Servo 라이브러리로 구현
+ * - [env:native] : HalNative.cpp 가 가상 핀과 가상 시계, 가상 EEPROM으로 구현 (HalNative.h)
+ */
+
+#ifndef SMARTCOOL_HAL_H
+#define SMARTCOOL_HAL_H
+
+#include <stdint.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+// 네이티브 빌드용 Arduino 호환 상수
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#endif
+
+namespace hal {
+
+unsigned long millis();
+unsigned long micros();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t level);
+uint8_t digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+
+// 파라솔 서보 (한 개만 사용). servoWrite()는 끊긴 출력을 다시 붙인다
+void servoAttach(uint8_t pin);
+void servoWrite(uint8_t angle);
+bool servoDetach();     // 펄스를 끊음. 펄스 도중이라 지금은 못 끊으면 false
+
+// 시리얼 송신. UART TX 링 버퍼에 넣기만 하고 전송은 인터럽트가 한다.
+// serialWritable()만큼은 블로킹 없이 serialWrite() 할 수 있다
+uint16_t serialWritable();
+void serialWrite(const uint8_t* data, uint8_t length);
+void serialFlush();     // 다 보낼 때까지 대기 (부팅/종료 시에만)
+
+// 내장 EEPROM (ATmega328P 1KB, 지운 상태 0xFF). eepromWrite()는 값이 다를 때만 쓴다
+// (바이트당 약 3.4ms, 수명 10만 회). 앞 쓰기가 안 끝났으면 기다리므로
+// 루프 안에서는 eepromReady()를 보고 한 바이트씩. 주소 배치는 EepromLayout.h
+const uint16_t EEPROM_SIZE = 1024;
+uint8_t eepromRead(uint16_t addr);
+void eepromWrite(uint16_t addr, uint8_t value);
+bool eepromReady();
+
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifdef ARDUINO
+
+#include "Hal.h"
+#include "ServoPwm.h"
+
+#include <avr/eeprom.h>
+
+namespace hal {
+
+unsigned long millis() { return ::millis(); }
+unsigned long micros() { return ::micros(); }
+
+void pinMode(uint8_t pin, uint8_t mode) { ::pinMode(pin, mode); }
+void digitalWrite(uint8_t pin, uint8_t level) { ::digitalWrite(pin, level); }
+uint8_t digitalRead(uint8_t pin) { return ::digitalRead(pin); }
+uint16_t analogRead(uint8_t pin) { return ::analogRead(pin); }
+
+// 서보는 핀 9 고정 (Timer1 OC1A 하드웨어 PWM, ServoPwm.h)
+void servoAttach(uint8_t) { servoPwm.attach(); }
+
+void servoWrite(uint8_t angle) {
+    servoPwm.write(angle);
+    if (!servoPwm.attached()) servoPwm.attach();
+}
+
+bool servoDetach() { return servoPwm.detach(); }
+
+uint16_t serialWritable() { return Serial.availableForWrite(); }
+void serialWrite(const uint8_t* data, uint8_t length) { Serial.write(data, length); }
+void serialFlush() { Serial.flush(); }
+
+uint8_t eepromRead(uint16_t addr) { return eeprom_read_byte((const uint8_t*)addr); }
+void eepromWrite(uint16_t addr, uint8_t value) { eeprom_update_byte((uint8_t*)addr, value); }
+bool eepromReady() { return eeprom_is_ready(); }
+
+}
+
+#endif
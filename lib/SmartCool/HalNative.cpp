@@ -0,0 +1,168 @@
+#ifndef ARDUINO
+
+#include "HalNative.h"
+
+namespace {
+
+unsigned long long nowMicros = 0;
+uint16_t analogValues[hal::native::PIN_COUNT];
+uint8_t pinLevels[hal::native::PIN_COUNT];
+uint8_t pinModes[hal::native::PIN_COUNT];
+uint8_t servoPin = 0xFF;
+uint8_t servoPosition = 0;
+bool servoPowered = false;
+unsigned long servoDetachCount = 0;
+unsigned long servoWriteCount = 0;
+unsigned long digitalWriteCount = 0;
+unsigned long pinWriteCounts[hal::native::PIN_COUNT];
+unsigned long long serialBusyUntil = 0;     // TX 링이 빌 때까지의 가상 시각
+std::string serialText;
+uint8_t eepromBytes[hal::EEPROM_SIZE];
+bool eepromErased = false;
+unsigned long eepromWriteCount = 0;
+unsigned long long eepromBusyUntil = 0;
+
+// 전역 초기화 순서와 상관없이 처음 쓸 때 지운 상태로
+void eepromInit() {
+    if (eepromErased) return;
+    for (uint16_t i = 0; i < hal::EEPROM_SIZE; i++) eepromBytes[i] = 0xFF;
+    eepromErased = true;
+}
+
+}
+
+namespace hal {
+
+unsigned long millis() { return (unsigned long)(nowMicros / 1000ULL); }
+unsigned long micros() { return (unsigned long)nowMicros; }
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin < native::PIN_COUNT) pinModes[pin] = mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t level) {
+    if (pin < native::PIN_COUNT) {
+        pinLevels[pin] = level ? HIGH : LOW;
+        pinWriteCounts[pin]++;
+    }
+    digitalWriteCount++;
+}
+
+uint8_t digitalRead(uint8_t pin) {
+    return pin < native::PIN_COUNT ? pinLevels[pin] : LOW;
+}
+
+uint16_t analogRead(uint8_t pin) {
+    return pin < native::PIN_COUNT ? analogValues[pin] : 0;
+}
+
+void servoAttach(uint8_t pin) {
+    servoPin = pin;
+    servoPowered = true;
+}
+
+void servoWrite(uint8_t angle) {
+    servoPosition = angle > 180 ? 180 : angle;
+    servoPowered = true;
+    servoWriteCount++;
+}
+
+bool servoDetach() {
+    if (servoPowered) servoDetachCount++;
+    servoPowered = false;
+    return true;
+}
+
+uint16_t serialWritable() {
+    if (serialBusyUntil <= nowMicros) return native::SERIAL_TX_CAPACITY;
+    unsigned long long queued =
+        (serialBusyUntil - nowMicros + native::SERIAL_BYTE_MICROS - 1) / native::SERIAL_BYTE_MICROS;
+    return queued >= native::SERIAL_TX_CAPACITY ? 0 : (uint16_t)(native::SERIAL_TX_CAPACITY - queued);
+}
+
+void serialWrite(const uint8_t* data, uint8_t length) {
+    // 실제 보드처럼 링이 꽉 차면 자리가 날 때까지 (가상 시계가) 기다린다
+    uint16_t writable = serialWritable();
+    if (length > writable) {
+        nowMicros += (length - writable) * (unsigned long long)native::SERIAL_BYTE_MICROS;
+    }
+    if (serialBusyUntil < nowMicros) serialBusyUntil = nowMicros;
+    serialBusyUntil += length * (unsigned long long)native::SERIAL_BYTE_MICROS;
+    serialText.append((const char*)data, length);
+}
+
+void serialFlush() {
+    if (serialBusyUntil > nowMicros) nowMicros = serialBusyUntil;
+}
+
+uint8_t eepromRead(uint16_t addr) {
+    eepromInit();
+    return addr < EEPROM_SIZE ? eepromBytes[addr] : 0xFF;
+}
+
+// 실제 칩처럼 앞 쓰기가 끝날 때까지(3.4ms) 기다린다
+void eepromWrite(uint16_t addr, uint8_t value) {
+    eepromInit();
+    if (addr >= EEPROM_SIZE || eepromBytes[addr] == value) return;
+    if (eepromBusyUntil > nowMicros) nowMicros = eepromBusyUntil;
+    eepromBytes[addr] = value;
+    eepromBusyUntil = nowMicros + 3400;
+    eepromWriteCount++;
+}
+
+bool eepromReady() { return eepromBusyUntil <= nowMicros; }
+
+namespace native {
+
+void reset() {
+    nowMicros = 0;
+    for (uint8_t i = 0; i < PIN_COUNT; i++) {
+        analogValues[i] = 0;
+        pinLevels[i] = LOW;
+        pinModes[i] = INPUT;
+        pinWriteCounts[i] = 0;
+    }
+    servoPin = 0xFF;
+    servoPosition = 0;
+    servoPowered = false;
+    servoDetachCount = 0;
+    servoWriteCount = 0;
+    digitalWriteCount = 0;
+    serialBusyUntil = 0;
+    serialText.clear();
+    eepromBusyUntil = 0;
+}
+
+void advanceMicros(unsigned long us) { nowMicros += us; }
+
+void setAnalog(uint8_t pin, uint16_t value) {
+    if (pin < PIN_COUNT) analogValues[pin] = value > 1023 ? 1023 : value;
+}
+
+uint8_t pinLevel(uint8_t pin) { return digitalRead(pin); }
+uint8_t servoAngle() { return servoPosition; }
+bool servoAttached() { return servoPin != 0xFF && servoPowered; }
+unsigned long servoDetaches() { return servoDetachCount; }
+unsigned long servoWrites() { return servoWriteCount; }
+unsigned long digitalWrites() { return digitalWriteCount; }
+unsigned long digitalWrites(uint8_t pin) { return pin < PIN_COUNT ? pinWriteCounts[pin] : 0; }
+const std::string& serialOutput() { return serialText; }
+void clearSerialOutput() { serialText.clear(); }
+
+void eraseEeprom() {
+    eepromErased = false;
+    eepromInit();
+    eepromWriteCount = 0;
+}
+
+uint8_t* eepromData() {
+    eepromInit();
+    return eepromBytes;
+}
+
+unsigned long eepromWrites() { return eepromWriteCount; }
+
+}
+}
+
+#endif
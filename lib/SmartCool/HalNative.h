@@ -0,0 +1,49 @@
+/*
+ * SmartCool Parasol - 네이티브(호스트) HAL 제어용 인터페이스
+ *
+ * 시계는 advance()로만 흐르는 가상 시계이고,
+ * 아날로그 입력은 setAnalog()로 주입, 출력 핀/서보 상태는 조회만 한다.
+ * 시리얼 송신은 9600bps UART(바이트당 1042us)와 TX 링 버퍼를 흉내 내며
+ * 보낸 내용은 serialOutput()에 쌓인다.
+ * EEPROM은 reset()(전원 재투입)에도 남고, eraseEeprom()으로만 지운다.
+ */
+
+#ifndef SMARTCOOL_HAL_NATIVE_H
+#define SMARTCOOL_HAL_NATIVE_H
+
+#ifndef ARDUINO
+
+#include <string>
+
+#include "Hal.h"
+
+namespace hal {
+namespace native {
+
+const uint8_t PIN_COUNT = 20;
+const uint16_t SERIAL_TX_CAPACITY = 255;        // [env:uno] SERIAL_TX_BUFFER_SIZE - 1
+const unsigned long SERIAL_BYTE_MICROS = 1042;  // 9600bps, 10비트/바이트
+
+void reset();
+void advanceMicros(unsigned long us);
+inline void advance(unsigned long ms) { advanceMicros(ms * 1000UL); }
+
+void setAnalog(uint8_t pin, uint16_t value);
+uint8_t pinLevel(uint8_t pin);
+uint8_t servoAngle();
+bool servoAttached();            // 핀이 붙어 있고 펄스가 나가는 중
+unsigned long servoDetaches();
+unsigned long servoWrites();
+unsigned long digitalWrites();
+unsigned long digitalWrites(uint8_t pin);
+const std::string& serialOutput();
+void clearSerialOutput();
+void eraseEeprom();
+uint8_t* eepromData();          // 손상 주입용
+unsigned long eepromWrites();   // 실제로 바뀐 바이트 수
+
+}
+}
+
+#endif
+#endif
@@ -0,0 +1,145 @@
+#include "Journal.h"
+#include "Hal.h"
+#include "Telemetry.h"
+
+Journal journal;
+
+static uint8_t checkNibble(uint8_t type, const uint8_t* bytes) {
+    uint8_t data[JOURNAL_RECORD_BYTES] = { type, bytes[1], bytes[2], bytes[3] };
+    return (uint8_t)(crc16Ccitt(data, sizeof(data)) & 0x0F);
+}
+
+void Journal::encode(uint8_t lapBit, const JournalEntry& e, uint8_t* bytes) {
+    bytes[1] = (uint8_t)e.deltaSeconds;
+    bytes[2] = (uint8_t)(e.deltaSeconds >> 8);
+    bytes[3] = e.arg;
+    bytes[0] = (uint8_t)((lapBit << 7) | ((e.type & 0x07) << 4) | checkNibble(e.type, bytes));
+}
+
+void Journal::decode(const uint8_t* bytes, JournalEntry& e) {
+    e.type = (bytes[0] >> 4) & 0x07;
+    e.deltaSeconds = (uint16_t)(bytes[1] | (bytes[2] << 8));
+    e.arg = bytes[3];
+    e.intact = e.type != JOURNAL_ERASED && (bytes[0] & 0x0F) == checkNibble(e.type, bytes);
+}
+
+uint8_t Journal::readHeader(uint16_t slot) {
+    return hal::eepromRead(slotAddr(slot));
+}
+
+Journal::Journal()
+    : head(0), lap(0), wrapped(false), flushing(false), writeByte(0), queue(), queueTail(0),
+      pendingCount(0), oldestAt(0), lastSeconds(0), counters() {
+}
+
+void Journal::begin() {
+    uint8_t first = readHeader(0);
+    uint8_t firstLap = first >> 7;
+
+    if (((first >> 4) & 0x07) == JOURNAL_ERASED) {
+        // 지운 칩: 첫 바퀴는 비트 0으로 써서 0xFF(비트 1)와 구분
+        head = 0;
+        lap = 0;
+        wrapped = false;
+    } else {
+        // [0, head)는 슬롯 0과 같은 바퀴, [head, N)은 다른 바퀴 (또는 지운 슬롯)
+        uint16_t lo = 1;
+        uint16_t hi = JOURNAL_SLOTS;
+        while (lo < hi) {
+            uint16_t mid = lo + ((hi - lo) >> 1);
+            if ((readHeader(mid) >> 7) == firstLap) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo == JOURNAL_SLOTS) {
+            // 바퀴가 딱 끝난 자리
+            head = 0;
+            lap = firstLap ^ 1;
+            wrapped = true;
+        } else {
+            head = lo;
+            lap = firstLap;
+            wrapped = ((readHeader(head) >> 4) & 0x07) != JOURNAL_ERASED;
+        }
+    }
+
+    flushing = false;
+    writeByte = 0;
+    queueTail = 0;
+    pendingCount = 0;
+    counters = JournalStats();
+    lastSeconds = hal::millis() / 1000;
+    record(JOURNAL_BOOT);
+}
+
+void Journal::record(JournalType type, uint8_t arg) {
+    if (pendingCount == JOURNAL_PENDING) {
+        if (counters.dropped < 0xFFFF) counters.dropped++;
+        return;
+    }
+
+    unsigned long now = hal::millis();
+    unsigned long seconds = now / 1000;
+    unsigned long delta = seconds - lastSeconds;
+    lastSeconds = seconds;
+
+    Pending& p = queue[(queueTail + pendingCount) & (JOURNAL_PENDING - 1)];
+    p.type = type;
+    p.arg = arg;
+    p.deltaSeconds = delta > 0xFFFF ? 0xFFFF : (uint16_t)delta;
+    if (pendingCount++ == 0) oldestAt = now;
+    if (pendingCount >= JOURNAL_BATCH) flushing = true;
+    if (counters.recorded < 0xFFFF) counters.recorded++;
+}
+
+void Journal::poll() {
+    if (!flushing) {
+        if (pendingCount == 0 || hal::millis() - oldestAt < JOURNAL_FLUSH_MS) return;
+        flushing = true;
+    }
+    if (!hal::eepromReady()) return;
+
+    const Pending& p = queue[queueTail];
+    JournalEntry e = { p.type, p.arg, p.deltaSeconds, true };
+    uint8_t bytes[JOURNAL_RECORD_BYTES];
+    encode(lap, e, bytes);
+
+    // 내용 1, 2, 3 다음 머리 0. 머리가 써져야 슬롯이 이번 바퀴로 바뀐다
+    uint8_t index = (writeByte + 1) & (JOURNAL_RECORD_BYTES - 1);
+    hal::eepromWrite(slotAddr(head) + index, bytes[index]);
+    if (++writeByte < JOURNAL_RECORD_BYTES) return;
+
+    writeByte = 0;
+    queueTail = (queueTail + 1) & (JOURNAL_PENDING - 1);
+    pendingCount--;
+    if (counters.written < 0xFFFF) counters.written++;
+    if (++head == JOURNAL_SLOTS) {
+        head = 0;
+        lap ^= 1;
+        wrapped = true;
+    }
+    // 내보내는 중에 들어온 기록도 같이 내보낸다
+    flushing = pendingCount > 0;
+}
+
+bool Journal::entry(uint16_t index, JournalEntry& out) const {
+    uint16_t stored = storedCount();
+    if (index < stored) {
+        uint16_t slot = wrapped ? (uint16_t)((head + index) % JOURNAL_SLOTS) : index;
+        uint8_t bytes[JOURNAL_RECORD_BYTES];
+        for (uint8_t i = 0; i < JOURNAL_RECORD_BYTES; i++) bytes[i] = hal::eepromRead(slotAddr(slot) + i);
+        decode(bytes, out);
+        return true;
+    }
+
+    index -= stored;
+    if (index >= pendingCount) return false;
+    const Pending& p = queue[(queueTail + index) & (JOURNAL_PENDING - 1)];
+    out.type = p.type;
+    out.arg = p.arg;
+    out.deltaSeconds = p.deltaSeconds;
+    out.intact = true;
+    return true;
+}
@@ -0,0 +1,113 @@
+/*
+ * SmartCool Parasol - EEPROM 이벤트 기록 (모드 전환, 펌프 ON/OFF, 수위 부족 정지)
+ *
+ * 리셋하면 RAM의 이력이 사라지므로 EEPROM에 덧붙이기만 하는 원형 버퍼로 남긴다.
+ * 슬롯은 4바이트 고정이고, 한 바퀴 돌 때마다 모든 슬롯을 한 번씩 써서 마모를 고르게 편다
+ * (192슬롯 × 10만 회 ≈ 1900만 건). 머리 위치를 따로 저장하는 칸은 없다.
+ *
+ *   바이트 0: [7] 바퀴 비트 | [6:4] 종류 | [3:0] 검사 니블 (CRC16 하위 4비트)
+ *   바이트 1-2: 앞 기록과의 시간 차 (초, 리틀 엔디언, 65535에서 포화)
+ *   바이트 3: 인자 (모드 번호, 펌프 정지 이유)
+ *
+ * 바퀴 비트는 바퀴마다 뒤집힌다. 지금 바퀴에서 쓴 슬롯 [0, head)와 아직 안 쓴 슬롯
+ * [head, N)은 바퀴 비트가 다르므로 부팅 때 이분 탐색으로 head를 찾는다 (EEPROM 8번 읽기).
+ * 지운 칩(0xFF)은 바퀴 1의 "종류 7"로 읽혀 첫 바퀴(비트 0)와 자연히 구분된다.
+ * 슬롯은 내용 3바이트를 먼저, 머리 바이트를 마지막에 쓴다. 중간에 전원이 나가면 그 슬롯은
+ * 예전 바퀴로 남아 head가 그대로다 (예전 기록만 검사 니블로 깨짐 표시).
+ *
+ * 기록은 RAM 대기열에 모았다가 JOURNAL_BATCH건이 차거나 가장 오래된 기록이
+ * JOURNAL_FLUSH_MS를 넘기면 한꺼번에 내보낸다. 내보내기도 poll()이 EEPROM이
+ * 준비됐을 때 한 바이트씩 써서 제어 루프를 막지 않는다 (바이트당 3.4ms).
+ * 전원이 나가면 대기열의 기록(최대 JOURNAL_FLUSH_MS 분량)은 잃는다.
+ */
+
+#ifndef SMARTCOOL_JOURNAL_H
+#define SMARTCOOL_JOURNAL_H
+
+#include <stdint.h>
+#include "EepromLayout.h"
+
+enum JournalType : uint8_t {
+    JOURNAL_BOOT = 0,
+    JOURNAL_MODE = 1,           // 인자: 새 모드
+    JOURNAL_PUMP_ON = 2,
+    JOURNAL_PUMP_OFF = 3,       // 인자: 0 모드 변경, 1 수위 부족
+    JOURNAL_ERASED = 7          // 지운 슬롯 (0xFF)
+};
+
+const uint8_t JOURNAL_RECORD_BYTES = 4;
+const uint16_t JOURNAL_SLOTS = EEPROM_JOURNAL_SIZE / JOURNAL_RECORD_BYTES;
+const uint8_t JOURNAL_PENDING = 8;          // RAM 대기열 (2의 거듭제곱)
+const uint8_t JOURNAL_BATCH = 4;
+const unsigned long JOURNAL_FLUSH_MS = 60000;
+
+static_assert(JOURNAL_SLOTS <= 0x7FFF, "journal slot index must fit int16_t");
+static_assert((JOURNAL_PENDING & (JOURNAL_PENDING - 1)) == 0, "JOURNAL_PENDING must be a power of two");
+
+struct JournalEntry {
+    uint8_t type;
+    uint8_t arg;
+    uint16_t deltaSeconds;
+    bool intact;                // 검사 니블이 맞음
+};
+
+struct JournalStats {
+    uint16_t recorded;          // 부팅 후 record() 건수
+    uint16_t written;           // EEPROM에 다 쓴 건수
+    uint16_t dropped;           // 대기열이 차서 버린 건수
+};
+
+class Journal {
+public:
+    Journal();
+
+    // head를 찾고 부팅 기록을 남긴다. controlBegin()에서
+    void begin();
+
+    // 대기열에 넣기만 한다 (EEPROM 쓰기 없음)
+    void record(JournalType type, uint8_t arg = 0);
+
+    // 메인 루프에서 매번. 내보낼 때가 됐으면 EEPROM이 준비될 때마다 한 바이트씩 쓴다
+    void poll();
+
+    // 다음 poll()부터 대기열을 바로 내보낸다
+    void flush() { flushing = pendingCount > 0; }
+
+    // 오래된 것부터 index번째 (EEPROM 기록 다음에 대기열). 범위 밖이면 false
+    bool entry(uint16_t index, JournalEntry& out) const;
+    uint16_t size() const { return storedCount() + pendingCount; }
+    uint16_t storedCount() const { return wrapped ? JOURNAL_SLOTS : head; }
+    uint8_t pending() const { return pendingCount; }
+    uint16_t headSlot() const { return head; }
+    const JournalStats& stats() const { return counters; }
+
+    // 머리 바이트, 내용 3바이트. 네이티브 테스트가 직접 만든 슬롯을 넣을 때도 쓴다
+    static void encode(uint8_t lap, const JournalEntry& e, uint8_t* bytes);
+    static void decode(const uint8_t* bytes, JournalEntry& e);
+
+private:
+    struct Pending {
+        uint8_t type;
+        uint8_t arg;
+        uint16_t deltaSeconds;
+    };
+
+    static uint8_t readHeader(uint16_t slot);
+    static uint16_t slotAddr(uint16_t slot) { return EEPROM_JOURNAL_ADDR + slot * JOURNAL_RECORD_BYTES; }
+
+    uint16_t head;              // 다음에 쓸 슬롯
+    uint8_t lap;                // 지금 바퀴의 비트 (0/1)
+    bool wrapped;               // 한 바퀴 이상 돌아 모든 슬롯에 기록이 있음
+    bool flushing;
+    uint8_t writeByte;          // 쓰는 중인 슬롯의 다음 바이트 (내용 1..3, 머리 0 순서)
+    Pending queue[JOURNAL_PENDING];
+    uint8_t queueTail;          // 가장 오래된 대기 기록
+    uint8_t pendingCount;
+    unsigned long oldestAt;     // 대기열 맨 앞이 들어온 시각
+    unsigned long lastSeconds;
+    JournalStats counters;
+};
+
+extern Journal journal;
+
+#endif
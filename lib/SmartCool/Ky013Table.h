@@ -0,0 +1,35 @@
+/*
+ * SmartCool Parasol - KY-013 NTC 원시값 → 온도 표 (Q8.8 °C)
+ *
+ * 자동 생성 파일: tools/gen_ky013_table.py 가 만든다. 직접 고치지 말 것.
+ * 배선 VCC - NTC - S - 10000Ω - GND, Steinhart-Hart A=1.009249522e-03 B=2.378405444e-04 C=2.019202697e-07
+ * 표[i] = 원시값 i × 16 의 온도. 사이 값은 SensorConversion.h가 선형 보간한다.
+ */
+
+#ifndef SMARTCOOL_KY013_TABLE_H
+#define SMARTCOOL_KY013_TABLE_H
+
+#include <stdint.h>
+#include "Progmem.h"
+
+const uint32_t KY013_SERIES_OHMS = 10000;
+constexpr double KY013_SH_A = 1.009249522e-03;     // 호스트 검증용 (펌웨어에는 링크되지 않음)
+constexpr double KY013_SH_B = 2.378405444e-04;
+constexpr double KY013_SH_C = 2.019202697e-07;
+
+const uint8_t KY013_TABLE_SHIFT = 4;
+const uint8_t KY013_TABLE_SIZE = 65;
+
+constexpr int16_t KY013_TABLE[KY013_TABLE_SIZE] PROGMEM = {
+    -24990, -15058, -12066, -10178,  -8762,  -7611,  -6631,  -5769,  // raw 0~
+     -4996,  -4290,  -3637,  -3026,  -2451,  -1905,  -1383,   -882,  // raw 128~
+      -398,     70,    526,    971,   1407,   1835,   2256,   2672,  // raw 256~
+      3084,   3492,   3898,   4302,   4706,   5110,   5515,   5922,  // raw 384~
+      6331,   6744,   7161,   7584,   8012,   8448,   8892,   9346,  // raw 512~
+      9811,  10288,  10778,  11285,  11809,  12354,  12921,  13515,  // raw 640~
+     14139,  14798,  15498,  16244,  17047,  17917,  18869,  19921,  // raw 768~
+     21102,  22448,  24018,  25904,  28266,  31420,  32767,  32767,  // raw 896~
+     32767,  // raw 1024~
+};
+
+#endif
@@ -0,0 +1,112 @@
+#include "Log.h"
+#include <string.h>
+
+static LogStats stats = { 0, 0, 0, 0 };
+static bool blocking = false;
+static bool textSent = false;     // 마지막으로 나간 것이 텍스트 줄
+
+void LogLine::put(char c) {
+    // 줄바꿈 2바이트 자리는 남겨 둔다
+    if (length < LOG_LINE_MAX - 2) {
+        buffer[length++] = c;
+    } else {
+        overflow = true;
+    }
+}
+
+void LogLine::append(const char* text) {
+    while (*text) put(*text++);
+}
+
+void LogLine::append(const __FlashStringHelper* text) {
+    const char* p = reinterpret_cast<const char*>(text);
+    char c;
+    while ((c = (char)pgm_read_byte(p++)) != 0) put(c);
+}
+
+void LogLine::append(char c) {
+    put(c);
+}
+
+void LogLine::append(long value) {
+    if (value < 0) {
+        put('-');
+        append((unsigned long)(-(value + 1)) + 1);
+    } else {
+        append((unsigned long)value);
+    }
+}
+
+void LogLine::append(unsigned long value) {
+    char digits[10];
+    uint8_t n = 0;
+    do {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+    while (n) put(digits[--n]);
+}
+
+void LogLine::append(Tenths value) {
+    long v = value.value;
+    if (v < 0) {
+        put('-');
+        v = -v;
+    }
+    append((unsigned long)(v / 10));
+    put('.');
+    put((char)('0' + v % 10));
+}
+
+bool LogLine::commit() {
+    buffer[length++] = '\r';
+    buffer[length++] = '\n';
+    if (overflow) stats.truncated++;
+    bool ok = logWrite((const uint8_t*)buffer, length);
+    if (ok) textSent = true;
+    length = 0;
+    overflow = false;
+    return ok;
+}
+
+bool logWrite(const uint8_t* data, uint8_t length) {
+    if (!blocking && hal::serialWritable() < length) {
+        stats.dropped++;
+        stats.droppedBytes += length;
+        return false;
+    }
+    hal::serialWrite(data, length);
+    stats.written++;
+    return true;
+}
+
+bool logWriteFrame(const uint8_t* frame, uint8_t length) {
+    if (!textSent) return logWrite(frame, length);
+
+    uint8_t buffer[LOG_LINE_MAX];
+    if (length >= sizeof(buffer)) return false;
+    buffer[0] = 0;
+    memcpy(buffer + 1, frame, length);
+    if (!logWrite(buffer, length + 1)) return false;
+    textSent = false;
+    return true;
+}
+
+void logSetBlocking(bool enable) {
+    blocking = enable;
+}
+
+void logFlush() {
+    hal::serialFlush();
+}
+
+const LogStats& logStats() {
+    return stats;
+}
+
+void logResetStats() {
+    stats.written = 0;
+    stats.dropped = 0;
+    stats.truncated = 0;
+    stats.droppedBytes = 0;
+}
@@ -0,0 +1,141 @@
+/*
+ * SmartCool Parasol - 비블로킹 시리얼 로거
+ *
+ * Serial.println()은 TX 링 버퍼가 차면 자리가 날 때까지 제어 루프를 세운다.
+ * 여기서는 한 줄을 스택의 LogLine에 모은 뒤, TX 링에 통째로 들어갈 자리가
+ * 있을 때만 한 번에 넣고 없으면 그 줄을 버리고 센다. 로그 한 번의 최악 비용은
+ * LOG_LINE_MAX 바이트 복사로 묶인다. 실제 전송은 UART 인터럽트가 한다.
+ *
+ *   LOG_INFO(F("온도: "), tenths(t), F("°C"));
+ *
+ * LOG_LEVEL(빌드 플래그) 아래 레벨의 매크로는 인자 평가까지 통째로 사라진다.
+ * TX 링 크기는 [env:uno]의 -DSERIAL_TX_BUFFER_SIZE로 정한다.
+ */
+
+#ifndef SMARTCOOL_LOG_H
+#define SMARTCOOL_LOG_H
+
+#include <stdint.h>
+#include "Hal.h"
+#include "Progmem.h"
+
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+// 한 줄 최대 길이 (한글 한 글자는 UTF-8 3바이트). 넘치는 부분은 잘린다
+#ifndef LOG_LINE_MAX
+#define LOG_LINE_MAX 96
+#endif
+
+struct LogStats {
+    unsigned long written;      // TX 링에 넣은 줄
+    unsigned long dropped;      // 자리가 없어 버린 줄
+    unsigned long truncated;    // LOG_LINE_MAX를 넘어 잘린 줄
+    unsigned long droppedBytes;
+};
+
+// 0.1 단위 정수를 "12.3"으로 출력하기 위한 표시
+struct Tenths {
+    int16_t value;
+};
+
+inline Tenths tenths(int16_t value) {
+    Tenths t = { value };
+    return t;
+}
+
+class LogLine {
+public:
+    LogLine() : length(0), overflow(false) {}
+
+    void append(const char* text);
+    void append(const __FlashStringHelper* text);
+    void append(char c);
+    void append(bool value) { append(value ? 1L : 0L); }
+    void append(int value) { append((long)value); }
+    void append(unsigned int value) { append((unsigned long)value); }
+    void append(long value);
+    void append(unsigned long value);
+    void append(Tenths value);
+
+    // 줄바꿈을 붙여 TX 링에 넣는다. 자리가 없으면 버리고 false
+    bool commit();
+
+    // 지금까지 모은 내용 (줄바꿈 전, 0으로 끝나지 않음)
+    const char* data() const { return buffer; }
+    uint8_t size() const { return length; }
+    // LOG_LINE_MAX를 넘어 잘린 글자가 있으면 true (commit 전까지)
+    bool truncated() const { return overflow; }
+
+private:
+    void put(char c);
+
+    char buffer[LOG_LINE_MAX];
+    uint8_t length;
+    bool overflow;
+};
+
+// 이미 만들어진 바이트열(텔레메트리 프레임 등)을 통째로 넣거나 버린다
+bool logWrite(const uint8_t* data, uint8_t length);
+
+// 0x00으로 끝나는 COBS 프레임. 바로 앞에 텍스트 줄이 나갔으면 구분자 0x00을
+// 하나 더 앞에 붙여 호스트가 텍스트와 프레임을 따로 자르게 한다
+bool logWriteFrame(const uint8_t* frame, uint8_t length);
+
+// 부팅 중에는 버리지 않고 자리가 날 때까지 기다리게 한다 (Serial.print와 같은 동작)
+void logSetBlocking(bool enable);
+
+// TX 링이 빌 때까지 대기. 부팅 메시지처럼 제어 루프 밖에서만 쓴다
+void logFlush();
+
+const LogStats& logStats();
+void logResetStats();
+
+// ============= 가변 인자 조립 =============
+inline void logAppend(LogLine&) {}
+
+template <typename T, typename... Rest>
+inline void logAppend(LogLine& line, T first, Rest... rest) {
+    line.append(first);
+    logAppend(line, rest...);
+}
+
+template <typename... Args>
+inline bool logMessage(Args... args) {
+    LogLine line;
+    logAppend(line, args...);
+    return line.commit();
+}
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) logMessage(__VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...) logMessage(__VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) logMessage(__VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) logMessage(__VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#endif
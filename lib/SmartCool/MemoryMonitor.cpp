@@ -0,0 +1,84 @@
+#include "MemoryMonitor.h"
+
+#if defined(__AVR__)
+
+#include <avr/io.h>
+#include <stddef.h>
+
+static const uint8_t STACK_CANARY = 0xC5;
+
+// 링커/avr-libc 심볼
+extern uint8_t __data_start;
+extern uint8_t __data_end;
+extern uint8_t __bss_start;
+extern uint8_t __bss_end;
+extern uint8_t __heap_start;
+extern char* __brkval;
+
+struct __freelist {
+    size_t sz;
+    struct __freelist* nx;
+};
+extern struct __freelist* __flp;
+
+// .init1: 스택이 비어 있고 r1(0 레지스터)도 아직 초기화 전이라 C 코드 대신 어셈블리로 칠한다
+extern "C" void memoryPaintStack() __attribute__((naked, used, section(".init1")));
+extern "C" void memoryPaintStack() {
+    __asm volatile(
+        "    ldi r30, lo8(_end)      \n"
+        "    ldi r31, hi8(_end)      \n"
+        "    ldi r24, 0xC5           \n"
+        "    ldi r25, hi8(__stack)   \n"
+        "    rjmp 2f                 \n"
+        "1:  st Z+, r24              \n"
+        "2:  cpi r30, lo8(__stack)   \n"
+        "    cpc r31, r25            \n"
+        "    brlo 1b                 \n"
+        "    breq 1b                 \n"
+        ::);
+}
+
+static uint8_t* heapEnd() {
+    return __brkval ? (uint8_t*)__brkval : &__heap_start;
+}
+
+void memorySnapshot(MemoryReport& report) {
+    uint8_t* stackPointer = (uint8_t*)(uintptr_t)SP;
+    uint8_t* top = heapEnd();
+
+    report.totalBytes = RAMEND - RAMSTART + 1;
+    report.dataBytes = &__data_end - &__data_start;
+    report.bssBytes = &__bss_end - &__bss_start;
+    report.heapBytes = top - &__heap_start;
+    report.freeBytes = stackPointer > top ? stackPointer - top : 0;
+    report.stackBytes = RAMEND - (uintptr_t)stackPointer;
+
+    report.heapFreeBytes = 0;
+    report.heapLargestFree = 0;
+    for (struct __freelist* block = __flp; block; block = block->nx) {
+        uint16_t size = block->sz + sizeof(size_t);
+        report.heapFreeBytes += size;
+        if (size > report.heapLargestFree) report.heapLargestFree = size;
+    }
+
+    // 힙 끝에서부터 카나리가 남은 바이트 수 = 스택이 한 번도 내려오지 않은 구간
+    uint8_t* p = top;
+    while (p < stackPointer && *p == STACK_CANARY) p++;
+    report.unusedMinBytes = p - top;
+    report.stackPeakBytes = RAMEND - (uintptr_t)p + 1;
+}
+
+#else
+
+#include <string.h>
+
+void memorySnapshot(MemoryReport& report) {
+    memset(&report, 0, sizeof(report));
+}
+
+#endif
+
+uint8_t heapFragmentationPercent(const MemoryReport& report) {
+    if (report.heapFreeBytes == 0) return 0;
+    return (uint8_t)(100 - (uint32_t)report.heapLargestFree * 100 / report.heapFreeBytes);
+}
@@ -0,0 +1,41 @@
+/*
+ * SmartCool Parasol - SRAM 사용량 계측 (ATmega328P, 2KB)
+ *
+ * 부팅 직후(.init1, 생성자보다 먼저) .bss 끝부터 RAMEND까지 카나리 값으로 칠해 두고,
+ * 나중에 힙 끝에서부터 칠이 남아 있는 바이트를 세어 스택이 가장 깊이
+ * 내려왔던 지점(high-water mark)을 구한다.
+ *
+ * 힙은 avr-libc malloc의 free list(__flp)를 따라가며 조각화 정도를 본다.
+ * String 같은 동적 할당이 남긴 구멍이 크면 큰 블록 하나를 못 잡는다.
+ *
+ *   정적 = .data + .bss (빌드마다 고정, tools/sram_report.py가 빌드 후에도 출력)
+ *   여유 = 스택 포인터 - 힙 끝 (지금 이 순간)
+ *   최소 여유 = 부팅 이후 한 번도 건드리지 않은 바이트 (스택/힙 충돌까지 남은 거리)
+ *
+ * AVR 전용. 네이티브 빌드에서는 모두 0을 돌려준다.
+ */
+
+#ifndef SMARTCOOL_MEMORY_MONITOR_H
+#define SMARTCOOL_MEMORY_MONITOR_H
+
+#include <stdint.h>
+
+struct MemoryReport {
+    uint16_t totalBytes;        // 내부 SRAM 전체
+    uint16_t dataBytes;         // .data (초기값 있는 전역)
+    uint16_t bssBytes;          // .bss (0 초기화 전역)
+    uint16_t heapBytes;         // 힙이 늘어난 크기 (해제된 블록 포함)
+    uint16_t heapFreeBytes;     // 힙 안의 해제된 블록 합
+    uint16_t heapLargestFree;   // 그중 가장 큰 블록
+    uint16_t freeBytes;         // 힙 끝 ~ 스택 포인터
+    uint16_t stackBytes;        // 지금 스택 깊이
+    uint16_t stackPeakBytes;    // 부팅 이후 최대 스택 깊이
+    uint16_t unusedMinBytes;    // 한 번도 쓰이지 않은 바이트 (최소 여유)
+};
+
+void memorySnapshot(MemoryReport& report);
+
+// 힙 해제 블록이 얼마나 잘게 쪼개졌는지 (0: 한 덩어리, 100에 가까울수록 조각남)
+uint8_t heapFragmentationPercent(const MemoryReport& report);
+
+#endif
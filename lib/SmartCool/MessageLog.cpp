@@ -0,0 +1,207 @@
+#include "MessageLog.h"
+#include "Telemetry.h"
+
+// CRC-8 (다항식 0x07). 프레임이 짧아 CRC16 대신 1바이트
+static uint8_t crc8(const uint8_t* data, size_t length) {
+    uint8_t crc = 0;
+    while (length--) {
+        crc ^= *data++;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint8_t* putVarint(uint8_t* p, uint32_t value) {
+    while (value >= 0x80) {
+        *p++ = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    *p++ = (uint8_t)value;
+    return p;
+}
+
+static const uint8_t* getVarint(const uint8_t* p, const uint8_t* end, uint32_t& value) {
+    value = 0;
+    for (uint8_t shift = 0; p < end && shift < 35; shift += 7) {
+        uint8_t b = *p++;
+        value |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return p;
+    }
+    return 0;
+}
+
+// 부호 있는 값을 작은 절댓값일수록 짧게 (-1 → 1, 1 → 2)
+static uint32_t zigzag(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t unzigzag(uint32_t value) {
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+// ============= 텍스트 펼치기 =============
+// {a|b|c}에서 index번째 선택지를 붙이고 닫는 } 뒤를 반환
+static const char* appendChoice(LogLine& line, const char* p, int32_t index) {
+    int32_t current = 0;
+    bool found = false;
+    char c;
+    while ((c = (char)pgm_read_byte(p)) != 0) {
+        p++;
+        if (c == '}') break;
+        if (c == '|') {
+            current++;
+        } else if (current == index) {
+            line.append(c);
+            found = true;
+        }
+    }
+    if (!found) line.append('?');
+    return p;
+}
+
+void messageExpand(LogLine& line, const char* textP, const int32_t* args, uint8_t count) {
+    uint8_t next = 0;
+    char c;
+    while ((c = (char)pgm_read_byte(textP)) != 0) {
+        textP++;
+        if (c != '{') {
+            line.append(c);
+            continue;
+        }
+
+        int32_t value = next < count ? args[next] : 0;
+        next++;
+        char kind = (char)pgm_read_byte(textP);
+        if (kind == '}') {
+            line.append((long)value);
+            textP++;
+        } else if (kind == '.') {
+            line.append(tenths((int16_t)value));
+            while ((c = (char)pgm_read_byte(textP)) != 0) {
+                textP++;
+                if (c == '}') break;
+            }
+        } else {
+            textP = appendChoice(line, textP, value);
+        }
+    }
+}
+
+bool messagePrint(const char* textP, const int32_t* args, uint8_t count) {
+    LogLine line;
+    messageExpand(line, textP, args, count);
+    return line.commit();
+}
+
+// ============= 프레임 =============
+uint8_t encodeMessageFrame(uint16_t id, const int32_t* args, uint8_t count, uint8_t* out) {
+    uint8_t raw[MESSAGE_RAW_MAX];
+    uint8_t* p = raw;
+    if (count > MESSAGE_ARGS_MAX) count = MESSAGE_ARGS_MAX;
+
+    if (id < MESSAGE_ID_EXTENDED) {
+        *p++ = (uint8_t)(MESSAGE_FRAME_TAG | id);
+    } else {
+        *p++ = (uint8_t)(MESSAGE_FRAME_TAG | MESSAGE_ID_EXTENDED | (id & 0x3F));
+        *p++ = (uint8_t)(id >> 6);
+    }
+    for (uint8_t i = 0; i < count; i++) p = putVarint(p, zigzag(args[i]));
+    *p = crc8(raw, p - raw);
+    p++;
+
+    uint8_t length = (uint8_t)cobsEncode(raw, p - raw, out);
+    out[length++] = 0;
+    return length;
+}
+
+bool decodeMessagePayload(const uint8_t* raw, size_t length, MessageRecord& record) {
+    if (length < 2 || !(raw[0] & MESSAGE_FRAME_TAG)) return false;
+    if (crc8(raw, length - 1) != raw[length - 1]) return false;
+
+    const uint8_t* p = raw + 1;
+    const uint8_t* end = raw + length - 1;
+    record.id = raw[0] & 0x3F;
+    if (raw[0] & MESSAGE_ID_EXTENDED) {
+        if (p >= end) return false;
+        record.id |= (uint16_t)*p++ << 6;
+    }
+    record.count = 0;
+    uint32_t value;
+    while (p < end) {
+        if (record.count >= MESSAGE_ARGS_MAX) return false;
+        if (!(p = getVarint(p, end, value))) return false;
+        record.args[record.count++] = unzigzag(value);
+    }
+    return true;
+}
+
+bool messageSend(uint16_t id, const int32_t* args, uint8_t count) {
+    uint8_t frame[MESSAGE_FRAME_MAX];
+    uint8_t length = encodeMessageFrame(id, args, count, frame);
+    return logWriteFrame(frame, length);
+}
+
+#ifndef ARDUINO
+static const char* const catalog[MSG_COUNT] = {
+#define SMARTCOOL_MESSAGE_STRING(id, text) text,
+    SMARTCOOL_MESSAGES(SMARTCOOL_MESSAGE_STRING)
+#undef SMARTCOOL_MESSAGE_STRING
+};
+
+const char* messageCatalogText(uint16_t id) {
+    return id < MSG_COUNT ? catalog[id] : 0;
+}
+
+bool looksLikeLogText(const uint8_t* data, size_t length) {
+    int continuation = 0;
+    for (size_t i = 0; i < length; i++) {
+        uint8_t b = data[i];
+        if (continuation) {
+            if ((b & 0xC0) != 0x80) return false;
+            continuation--;
+        } else if (b < 0x20) {
+            if (b != '\t' && b != '\r' && b != '\n') return false;
+        } else if (b < 0x80) {
+            continue;
+        } else if (b >= 0xC2 && b <= 0xDF) {
+            continuation = 1;
+        } else if (b >= 0xE0 && b <= 0xEF) {
+            continuation = 2;
+        } else if (b >= 0xF0 && b <= 0xF4) {
+            continuation = 3;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+LogStreamSplitter::Chunk LogStreamSplitter::feed(uint8_t byte) {
+    if (ready) {
+        length = 0;
+        ready = false;
+    }
+    if (byte == 0) {
+        // 빈 덩어리(연속된 0x00)는 무시
+        if (length == 0) return CHUNK_NONE;
+        ready = true;
+        return CHUNK_BLOCK;
+    }
+    // 구분자도 줄바꿈도 없이 너무 길면 버린다
+    if (length == LOG_STREAM_CHUNK_MAX) length = 0;
+    buffer[length++] = byte;
+    if (byte == '\n' && length >= 2 && buffer[length - 2] == '\r' && looksLikeLogText(buffer, length)) {
+        ready = true;
+        return CHUNK_TEXT;
+    }
+    return CHUNK_NONE;
+}
+
+LogStreamSplitter::Chunk LogStreamSplitter::finish() {
+    if (ready || length == 0 || !looksLikeLogText(buffer, length)) return CHUNK_NONE;
+    ready = true;
+    return CHUNK_TEXT;
+}
+#endif
@@ -0,0 +1,165 @@
+/*
+ * SmartCool Parasol - 카탈로그 메시지 로그
+ *
+ *   LOGM_INFO(MSG_STATUS_WATER, tenths(percent), waterOK);
+ *   LOGM_REPLY(MSG_MEM_FREE, free, unusedMin);    // 명령 응답은 레벨과 무관
+ *
+ * 메시지 문장은 Messages.h 카탈로그에 번호로 모여 있다. 자리 표시 개수와
+ * 인자 개수가 다르면 컴파일 오류. 인자는 모두 32비트 정수로 바뀐다.
+ *
+ * 텍스트 빌드(기본): 카탈로그 문장을 플래시에서 읽어 LogLine에 펼쳐 보낸다.
+ *   쓰인 메시지의 문장만 플래시에 링크된다.
+ * 카탈로그 빌드(-DLOG_CATALOG=1, [env:uno_catalog]): 문장은 아예 링크되지 않고
+ *   [번호][인자...][CRC8]을 COBS로 감싼 프레임만 보낸다. 번호는 최상위 비트를 켜
+ *   텔레메트리 프레임(첫 바이트 = 버전 2)과 구분하고, 인자는 zigzag varint라
+ *   작은 값은 1바이트. 30~50바이트 텍스트 줄이 5~10바이트가 된다.
+ *   호스트 도구([env:telemetry])가 텔레메트리 프레임, 텍스트 줄과 함께 풀어 준다.
+ */
+
+#ifndef SMARTCOOL_MESSAGE_LOG_H
+#define SMARTCOOL_MESSAGE_LOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Log.h"
+#include "Messages.h"
+#include "Progmem.h"
+
+#ifndef LOG_CATALOG
+#define LOG_CATALOG 0
+#endif
+
+// 첫 바이트 1xnnnnnn: 번호 하위 6비트. x가 1이면 다음 바이트가 번호 상위 8비트
+const uint8_t MESSAGE_FRAME_TAG = 0x80;
+const uint8_t MESSAGE_ID_EXTENDED = 0x40;
+const uint8_t MESSAGE_ARGS_MAX = 10;
+
+// 번호 2 + 인자 5 x 10 + CRC 1, COBS 오버헤드 1, 구분자 1
+const uint8_t MESSAGE_RAW_MAX = 2 + 5 * MESSAGE_ARGS_MAX + 1;
+const uint8_t MESSAGE_FRAME_MAX = MESSAGE_RAW_MAX + 2;
+
+struct MessageRecord {
+    uint16_t id;
+    uint8_t count;
+    int32_t args[MESSAGE_ARGS_MAX];
+};
+
+// 컴파일 타임: 카탈로그 문장의 자리 표시({...}) 개수
+constexpr unsigned messagePlaceholders(const char* text) {
+    return *text == 0 ? 0 : (*text == '{' ? 1 : 0) + messagePlaceholders(text + 1);
+}
+
+// 메시지별 문장. 호출된 메시지의 flash()만 PSTR을 만든다
+template <MessageId Id> struct MessageText;
+
+#define SMARTCOOL_MESSAGE_TEXT(id, text) \
+    template <> struct MessageText<id> { \
+        static constexpr unsigned args = messagePlaceholders(text); \
+        static const char* flash() { return PSTR(text); } \
+    };
+SMARTCOOL_MESSAGES(SMARTCOOL_MESSAGE_TEXT)
+#undef SMARTCOOL_MESSAGE_TEXT
+
+// 플래시 문장의 자리 표시를 args로 채워 line에 붙인다 (호스트에서는 RAM 문장도 된다)
+void messageExpand(LogLine& line, const char* textP, const int32_t* args, uint8_t count);
+
+// 구분자 0x00까지 포함한 프레임을 out(MESSAGE_FRAME_MAX)에 쓰고 길이 반환
+uint8_t encodeMessageFrame(uint16_t id, const int32_t* args, uint8_t count, uint8_t* out);
+
+// COBS를 푼 프레임 내용. 첫 바이트 태그나 CRC가 틀리면 false
+bool decodeMessagePayload(const uint8_t* raw, size_t length, MessageRecord& record);
+
+// LOGM_* 매크로가 부른다 (텍스트 빌드 / 카탈로그 빌드)
+bool messagePrint(const char* textP, const int32_t* args, uint8_t count);
+bool messageSend(uint16_t id, const int32_t* args, uint8_t count);
+
+#ifndef ARDUINO
+// 호스트 전용: 번호 → 카탈로그 문장 (없는 번호는 0)
+const char* messageCatalogText(uint16_t id);
+
+// 호스트 전용: 올바른 UTF-8 텍스트인지 (제어 문자는 탭/줄바꿈만)
+bool looksLikeLogText(const uint8_t* data, size_t length);
+
+// 호스트 전용: 시리얼 스트림을 텍스트 줄과 COBS 블록(구분자 0x00 앞)으로 가른다.
+// 텍스트만 오는 동안에는 구분자가 없으므로 줄 끝에서 내보내는데, LogLine은 항상
+// "\r\n"으로 끝나므로 '\n' 하나만으로는 줄로 보지 않는다. 프레임의 COBS 코드 바이트가
+// 0x0A일 수 있기 때문이다. 프레임 둘째 바이트(메시지 번호 0x80 이상, 텔레메트리 버전)는
+// UTF-8 텍스트가 될 수 없으므로 프레임이 "\r\n"까지 텍스트로 보일 일은 없다
+const size_t LOG_STREAM_CHUNK_MAX = 4096;
+
+class LogStreamSplitter {
+public:
+    enum Chunk {
+        CHUNK_NONE,
+        CHUNK_TEXT,     // 줄바꿈까지의 텍스트 (여러 줄일 수 있다)
+        CHUNK_BLOCK     // 구분자 앞 블록. 메시지/텔레메트리 프레임이거나 구분자 앞 텍스트
+    };
+
+    LogStreamSplitter() : length(0), ready(false) {}
+
+    // 덩어리가 끝나면 CHUNK_TEXT/CHUNK_BLOCK. 내용은 다음 feed() 전까지 data()/size()
+    Chunk feed(uint8_t byte);
+
+    // 스트림 끝. 남은 내용이 텍스트면 CHUNK_TEXT
+    Chunk finish();
+
+    const uint8_t* data() const { return buffer; }
+    size_t size() const { return length; }
+
+private:
+    uint8_t buffer[LOG_STREAM_CHUNK_MAX];
+    size_t length;
+    bool ready;
+};
+#endif
+
+// ============= 인자 변환 =============
+inline int32_t messageArg(int value) { return value; }
+inline int32_t messageArg(unsigned int value) { return (int32_t)value; }
+inline int32_t messageArg(long value) { return value; }
+inline int32_t messageArg(unsigned long value) { return (int32_t)value; }
+inline int32_t messageArg(bool value) { return value ? 1 : 0; }
+inline int32_t messageArg(Tenths value) { return value.value; }
+
+template <MessageId Id, typename... Args>
+inline bool logCatalog(Args... args) {
+    static_assert(MessageText<Id>::args == sizeof...(Args),
+                  "message placeholder count does not match argument count");
+    static_assert(sizeof...(Args) <= MESSAGE_ARGS_MAX, "too many message arguments");
+    const int32_t values[sizeof...(Args) + 1] = { messageArg(args)..., 0 };
+#if LOG_CATALOG
+    return messageSend(Id, values, sizeof...(Args));
+#else
+    return messagePrint(MessageText<Id>::flash(), values, sizeof...(Args));
+#endif
+}
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOGM_ERROR(id, ...) logCatalog<id>(__VA_ARGS__)
+#else
+#define LOGM_ERROR(id, ...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOGM_WARN(id, ...) logCatalog<id>(__VA_ARGS__)
+#else
+#define LOGM_WARN(id, ...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOGM_INFO(id, ...) logCatalog<id>(__VA_ARGS__)
+#else
+#define LOGM_INFO(id, ...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOGM_DEBUG(id, ...) logCatalog<id>(__VA_ARGS__)
+#else
+#define LOGM_DEBUG(id, ...) ((void)0)
+#endif
+
+// 시리얼 명령에 대한 응답. 사용자가 요청한 출력이라 LOG_LEVEL과 상관없이 항상 보낸다
+// ([env:uno_release]의 LOG_LEVEL=2에서도 m/j/c 명령이 동작해야 한다)
+#define LOGM_REPLY(id, ...) logCatalog<id>(__VA_ARGS__)
+
+#endif
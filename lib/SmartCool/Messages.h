@@ -0,0 +1,133 @@
+/*
+ * SmartCool Parasol - 로그 메시지 카탈로그
+ *
+ * 이벤트/상태 줄을 번호로 관리한다. 텍스트 빌드는 이 문장을 플래시에서 펼쳐
+ * 보내고, 카탈로그 빌드(-DLOG_CATALOG=1)는 번호와 인자만 보낸다. 호스트 도구
+ * ([env:telemetry])가 같은 표로 다시 문장을 만든다.
+ *
+ * 자리 표시
+ *   {}       정수
+ *   {.1}     0.1 단위 정수 (285 → 28.5)
+ *   {a|b|c}  인자 값이 고르는 선택지 (0 → a, 1 → b ...). 범위 밖이면 ?
+ *
+ * 번호는 목록 순서다. 새 메시지는 반드시 맨 끝에 붙인다.
+ * 중간에 끼우면 번호가 밀려 이미 받은 로그를 잘못 읽는다.
+ */
+
+#ifndef SMARTCOOL_MESSAGES_H
+#define SMARTCOOL_MESSAGES_H
+
+#include <stdint.h>
+
+#define SMARTCOOL_MESSAGES(X) \
+    /* ---- src/main.cpp ---- */ \
+    X(MSG_HWTEST_TEMP,          "온도: {.1}°C [{정상|더위!}]") \
+    X(MSG_HWTEST_WATER,         "수위: {} [{부족|충분}]") \
+    X(MSG_MODE_CHANGED,         "{대기|비|더위} 모드") \
+    X(MSG_PUMP_STARTED,         "미스트 분사 시작") \
+    X(MSG_PUMP_LOW_WATER,       "수위 부족 - 펌프 정지") \
+    X(MSG_STATUS_HEADER,        "===== 시스템 상태 =====") \
+    X(MSG_STATUS_TEMP_RAIN,     "온도: {.1}°C [{정상|더위감지}] | 비: {} [{없음|감지}]") \
+    X(MSG_STATUS_WATER,         "수위: {.1}% [{부족|충분}]") \
+    X(MSG_STATUS_PARASOL,       "파라솔: {수납|전개}") \
+    X(MSG_STATUS_PARASOL_MOVE,  "파라솔: {수납|전개} (이동 중 {}%, {}ms 남음)") \
+    X(MSG_STATUS_PUMP_MODE,     "펌프: {OFF|ON} | 모드: {대기|비|더위}") \
+    X(MSG_STATUS_COMMANDS,      "명령 적용/생략: 릴레이 {}/{} | 파라솔 {}/{}") \
+    X(MSG_STATUS_LOG,           "로그: 전송 {} | 버림 {} ({}B) | 잘림 {}") \
+    X(MSG_STATUS_SRAM,          "SRAM 여유 {}B | 최소 여유 {}B | 스택 최대 {}B") \
+    X(MSG_REPORT_FOOTER,        "==========================") \
+    X(MSG_MEM_HEADER,           "===== SRAM ({}B) =====") \
+    X(MSG_MEM_STATIC,           "정적: .data {}B + .bss {}B = {}B") \
+    X(MSG_MEM_HEAP,             "힙: {}B (해제 블록 {}B, 최대 {}B, 조각화 {}%)") \
+    X(MSG_MEM_STACK,            "스택: 현재 {}B | 최대 {}B") \
+    X(MSG_MEM_FREE,             "여유: 현재 {}B | 부팅 후 최소 {}B") \
+    X(MSG_PROF_HEADER,          "===== 실행 시간 (us) =====") \
+    X(MSG_PROF_BUCKETS,         "히스토그램 구간: <16 <32 <64 <128 <256 <512 <1k <2k <4k 4k+") \
+    X(MSG_PROF_STAGE,           "{센싱|모드|파라솔|펌프|보고|루프} n={} 평균 {} 최소 {} 최대 {}") \
+    X(MSG_PROF_HISTOGRAM,       "       {} {} {} {} {} {} {} {} {} {}") \
+    X(MSG_PROF_OVERRUNS,        "5ms 초과 {} | 마감 센싱 {} 모드 {} 구동 {} 모션 {} 보고 {}") \
+    /* ---- demo/demo_main.cpp ---- */ \
+    X(MSG_DEMO_TIMEOUT,         "데모 시간 종료 - 대기 모드로 복귀") \
+    X(MSG_DEMO_START,           "{더위 대응|빗물 수집|미스트 분사} 모드 데모 시작") \
+    X(MSG_DEMO_ACTIVE,          "{더위 대응|빗물 수집|미스트 분사} 모드 활성화 완료!") \
+    X(MSG_DEMO_PARASOL_BEGIN,   "파라솔 동작 테스트 시작") \
+    X(MSG_DEMO_PARASOL_DONE,    "파라솔 동작 테스트 완료!") \
+    X(MSG_DEMO_STANDBY,         "대기 모드 활성화 완료") \
+    X(MSG_DEMO_RELAY,           "   워터펌프 {OFF (릴레이 LOW)|ON (릴레이 HIGH)}") \
+    X(MSG_DEMO_ETA,             "   도착 예상: {}ms") \
+    X(MSG_DEMO_PARASOL,         "   파라솔: {수납됨|전개됨}") \
+    X(MSG_DEMO_PUMP,            "   워터펌프: {정지|가동중}") \
+    X(MSG_DEMO_MODE,            "   동작모드: {대기|빗물수집|더위대응|미스트}") \
+    X(MSG_DEMO_SRAM_FREE,       "   여유: {}B (부팅 후 최소 {}B)") \
+    X(MSG_DEMO_SRAM_STACK,      "   스택 최대: {}B | 정적: {}B") \
+    X(MSG_DEMO_SRAM_HEAP,       "   힙: {}B, 조각화 {}%") \
+    X(MSG_DEMO_TEMP,            "   온도: {.1}°C (Raw: {})") \
+    X(MSG_DEMO_RAIN,            "   빗물: {} (임계값: 700 이하)") \
+    X(MSG_DEMO_WATER,           "   수위: {} (임계값: 600 이상)") \
+    /* ---- test/simple_pump_test.cpp ---- */ \
+    X(MSG_PT_PUMP,              "워터펌프 {OFF|ON}") \
+    X(MSG_PT_RUN_TIME,          "펌프 가동 시간: {}초") \
+    X(MSG_PT_TOTAL_RUN_TIME,    "   총 가동 시간: {}초") \
+    X(MSG_PT_TEST_BEGIN,        "{빠른 테스트 시작 (3초)|긴 테스트 시작 (10초)|반복 테스트 시작 (1초 ON/OFF x 5회)}") \
+    X(MSG_PT_TEST_DONE,         "{빠른|긴|반복} 테스트 완료") \
+    X(MSG_PT_COUNTDOWN,         "   {}초 남음...") \
+    X(MSG_PT_CYCLE,             "  사이클 {}/5") \
+    X(MSG_PT_RELAY,             "   릴레이 (D6): {LOW (OFF)|HIGH (ON)}") \
+    X(MSG_PT_PUMP_RUNNING,      "   워터펌프: 동작 중 ({}초)") \
+    X(MSG_PT_LED,               "   상태 LED: {꺼짐|켜짐}") \
+    X(MSG_PT_UPTIME,            "   업타임: {}초") \
+    X(MSG_PT_EMERGENCY,         "긴급 정지!") \
+    /* ---- test/circuit_test.cpp ---- */ \
+    X(MSG_CT_PHASE_BEGIN,       "=== {}단계: {전원 공급|릴레이 동작|워터펌프 안전성|워터펌프 동작|내구성} 테스트 ===") \
+    X(MSG_CT_PHASE_RESULT,      "{❌ 실패|✅ 통과}: {전원 공급 안정성 확인 완료|릴레이 동작 테스트 완료|워터펌프 안전성 테스트 통과|워터펌프 동작 테스트 통과|내구성 테스트 완료}") \
+    X(MSG_CT_POWER_CHECK,       "전원 체크... {}/5초") \
+    X(MSG_CT_RELAY,             "{릴레이 OFF|릴레이 ON... (딸깍 소리 확인!)}") \
+    X(MSG_CT_PUMP,              "{워터펌프 OFF|🚰 워터펌프 ON (1초 안전 테스트)|🚰 워터펌프 연속 동작 시작 (5초)|워터펌프 정지}") \
+    X(MSG_CT_RUNNING,           "동작 중... 남은 시간: {}초") \
+    X(MSG_CT_CYCLE_BEGIN,       "🔄 사이클 {}/5 시작") \
+    X(MSG_CT_CYCLE_PUMP,        "  워터펌프 {OFF (5초 대기)|ON (3초)}") \
+    X(MSG_CT_CYCLE_ON,          "    ON 상태... {}초 남음") \
+    X(MSG_CT_CYCLE_WAIT,        "    대기 중... {}초 남음") \
+    X(MSG_CT_CYCLE_DONE,        "  사이클 {} 완료") \
+    X(MSG_CT_WAIT_INPUT,        "   입력 대기 ({}초 제한)...") \
+    X(MSG_CT_ANSWER,            "{👎 문제 있음 - 테스트 중단|👍 확인 - 계속 진행|⏰ 시간 초과 - 기본값(예)으로 진행}") \
+    X(MSG_CT_EMERGENCY,         "🚨🚨🚨 긴급정지 실행! 🚨🚨🚨") \
+    X(MSG_CT_TOTAL_TIME,        "총 테스트 시간: {}초") \
+    /* ---- 추가 (src/main.cpp) ---- */ \
+    X(MSG_STATUS_RAIN_ONSET,    "비 빠른 경로: 감지 {} | 선점 {} | 지연 최근 {}us 최대 {}us") \
+    X(MSG_STATUS_HUMIDITY,      "습도: {.1}% [{끊김|정상}] | 체감: {.1}°C") \
+    X(MSG_SELFTEST_CACHED,      "지난 자가 진단: {실패 있음 - 진단 후 제어|모두 통과 - 바로 제어} ({}회, 서보 왕복 {}ms)") \
+    X(MSG_SELFTEST_NO_CACHE,    "자가 진단 기록 없음 - 진단 후 제어") \
+    X(MSG_SELFTEST_DONE,        "자가 진단 완료: 센서 {실패|통과} | 서보 {실패|통과} ({}ms) | 릴레이 {실패|통과}") \
+    X(MSG_SELFTEST_ABORTED,     "자가 진단 중단 - 모드 변경, 대기 모드에서 다시 시작") \
+    X(MSG_JOURNAL_HEADER,       "===== 이벤트 기록 {}건 (EEPROM {}/{}, 대기 {}, 버림 {}) =====") \
+    X(MSG_JOURNAL_BOOT,         "#{} 부팅") \
+    X(MSG_JOURNAL_MODE,         "#{} +{}s {대기|비|더위} 모드") \
+    X(MSG_JOURNAL_PUMP_ON,      "#{} +{}s 펌프 ON") \
+    X(MSG_JOURNAL_PUMP_OFF,     "#{} +{}s 펌프 OFF ({모드 변경|수위 부족})") \
+    X(MSG_JOURNAL_PUMP_RUN,     "#{} +{}s 펌프 OFF ({모드 변경|수위 부족}), 가동 {}s") \
+    X(MSG_JOURNAL_DAMAGED,      "#{} 깨진 기록") \
+    X(MSG_CAL_HEADER,           "===== 보정값: {기본값|EEPROM} 순번 {} (온도 0.1°C, 나머지 ADC 원시값) =====") \
+    X(MSG_CAL_VALUE,            "{heat|heat_hyst|rain|rain_hyst|water|water_empty|water_full} = {} (편집 {}, 범위 {}~{})") \
+    X(MSG_CAL_SET,              "{heat|heat_hyst|rain|rain_hyst|water|water_empty|water_full} 편집 {} - c save로 적용") \
+    X(MSG_CAL_APPLIED,          "보정값 적용, EEPROM 저장 순번 {}") \
+    X(MSG_CAL_EDIT,             "{편집본을 사용 중인 값으로 되돌림|편집본을 기본값으로 (c save로 적용)}") \
+    X(MSG_CAL_ERROR,            "보정 오류: {정상|알 수 없는 항목|값 범위 밖|수위 빈 값이 가득 값 이상|비 경계 + 간격이 1023 초과}") \
+    X(MSG_CAL_USAGE,            "사용법: c [<항목> <값>|save|revert|defaults|auto [stop]|propose]") \
+    X(MSG_AUTOCAL_STATE,        "자동 보정 {중지|시작} (샘플 {}개, {}초 간격)") \
+    X(MSG_AUTOCAL_HEADER,       "===== 자동 보정 ({중지|수집 중}, 샘플 {}개) =====") \
+    X(MSG_AUTOCAL_CHANNEL,      "{빗물|수위}: 최소 {} 하위 5% {} 상위 95% {} 최대 {}") \
+    X(MSG_AUTOCAL_RAIN,         "제안 rain {} (젖음 {} / 마름 {} 가운데)") \
+    X(MSG_AUTOCAL_WATER,        "제안 water_empty {} water_full {} water {}") \
+    X(MSG_AUTOCAL_SKIP,         "{빗물|수위} 제안 없음: {정상|샘플 부족|값 변화 폭이 좁음}") \
+    X(MSG_AUTOCAL_LOADED,       "제안 {}개를 편집본에 넣음 - c save로 적용") \
+    X(MSG_STATUS_DHT,           "DHT 읽기 {} | 체크섬 오류 {} | 응답 없음 {}")
+
+enum MessageId {
+#define SMARTCOOL_MESSAGE_ID(id, text) id,
+    SMARTCOOL_MESSAGES(SMARTCOOL_MESSAGE_ID)
+#undef SMARTCOOL_MESSAGE_ID
+    MSG_COUNT
+};
+
+#endif
@@ -0,0 +1,50 @@
+/*
+ * SmartCool Parasol - 모드 전이 테이블
+ *
+ * 행 = 현재 모드, 열 = (비 감지 << 1 | 더위 감지) 입력 코드.
+ * 모드마다 비/더위 판정 경계값(ModeBounds)을 따로 가지므로
+ * 같은 센서값이라도 "들어갈 때"와 "나올 때" 경계가 달라진다(에지별 히스테리시스).
+ * 더위 경계는 온도 원시값과 체감 온도 두 가지를 두고, 습도 값이 살아 있으면 체감 온도를 쓴다.
+ * 각 칸(에지)은 다음 모드와, 그 전이 전에 현재 모드에 머물러야 하는 최소 시간을 가진다.
+ *
+ * 에지 테이블은 constexpr 함수로 컴파일 타임에 만들어 PROGMEM에 둔다.
+ * 경계값은 현장 보정(Calibration.h)으로 바뀌므로 RAM에 두고, 보정값이 바뀔 때만 다시 계산한다.
+ * 판정은 비교 2번 + 테이블 조회 1번으로 끝난다 (if/else 연쇄 없음).
+ */
+
+#ifndef SMARTCOOL_MODE_TABLE_H
+#define SMARTCOOL_MODE_TABLE_H
+
+#include <stdint.h>
+#include "Progmem.h"
+
+const uint8_t INPUT_RAIN = 0x02;
+const uint8_t INPUT_HEAT = 0x01;
+const uint8_t INPUT_CODES = 4;
+
+struct ModeEdge {
+    uint8_t next;
+    uint8_t dwellSec;       // 현재 모드 최소 유지 시간 (초)
+};
+
+struct ModeRow {
+    ModeEdge edges[INPUT_CODES];
+};
+
+struct ModeBounds {
+    uint16_t rainBelow;     // rainRaw < rainBelow 이면 비
+    uint16_t heatAbove;     // tempRaw > heatAbove 이면 더위 (습도 없을 때)
+    int16_t heatIndexAbove; // 습도가 있으면 체감 온도(Q8.8) > heatIndexAbove 이면 더위
+};
+
+// 입력 코드별 목표 모드 (비 우선)
+constexpr uint8_t desiredMode(uint8_t code, uint8_t standby, uint8_t rain, uint8_t heat) {
+    return (code & INPUT_RAIN) ? rain : ((code & INPUT_HEAT) ? heat : standby);
+}
+
+// 한 에지: 모드가 그대로면 대기시간 0, 아니면 진입 모드별 대기시간
+constexpr ModeEdge makeEdge(uint8_t from, uint8_t to, uint8_t dwellSec) {
+    return ModeEdge{ to, from == to ? (uint8_t)0 : dwellSec };
+}
+
+#endif
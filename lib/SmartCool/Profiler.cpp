@@ -0,0 +1,75 @@
+#include "Profiler.h"
+
+#if PROFILE_ENABLED
+
+static StageStats stages[STAGE_COUNT];
+static unsigned long lastLoopMicros = 0;
+static bool loopStarted = false;
+static uint16_t loopOverruns = 0;
+
+static uint8_t bucketOf(unsigned long us) {
+    uint8_t b = 0;
+    us >>= 4;
+    while (us && b < PROFILE_BUCKETS - 1) {
+        us >>= 1;
+        b++;
+    }
+    return b;
+}
+
+void profileRecord(uint8_t stage, unsigned long us) {
+    StageStats& s = stages[stage];
+    uint16_t clamped = us > 0xFFFF ? 0xFFFF : (uint16_t)us;
+
+    if (s.count == 0 || clamped < s.minUs) s.minUs = clamped;
+    if (clamped > s.maxUs) s.maxUs = clamped;
+    if (s.count < 0xFFFF) {
+        s.count++;
+        s.totalUs += clamped;
+    }
+
+    uint8_t b = bucketOf(us);
+    if (s.buckets[b] == 0xFF) {
+        for (uint8_t i = 0; i < PROFILE_BUCKETS; i++) s.buckets[i] >>= 1;
+    }
+    s.buckets[b]++;
+}
+
+void profileLoopTick() {
+    unsigned long now = hal::micros();
+    if (loopStarted) {
+        unsigned long gap = now - lastLoopMicros;
+        profileRecord(STAGE_LOOP, gap);
+        if (gap > PROFILE_LOOP_BUDGET_US && loopOverruns < 0xFFFF) loopOverruns++;
+    }
+    lastLoopMicros = now;
+    loopStarted = true;
+}
+
+void profileReset() {
+    for (uint8_t i = 0; i < STAGE_COUNT; i++) {
+        StageStats& s = stages[i];
+        s.count = 0;
+        s.minUs = 0;
+        s.maxUs = 0;
+        s.totalUs = 0;
+        for (uint8_t b = 0; b < PROFILE_BUCKETS; b++) s.buckets[b] = 0;
+    }
+    loopStarted = false;
+    loopOverruns = 0;
+}
+
+const StageStats& profileStage(uint8_t stage) {
+    return stages[stage];
+}
+
+uint16_t profileMeanUs(uint8_t stage) {
+    const StageStats& s = stages[stage];
+    return s.count ? (uint16_t)(s.totalUs / s.count) : 0;
+}
+
+uint16_t profileLoopOverruns() {
+    return loopOverruns;
+}
+
+#endif
@@ -0,0 +1,86 @@
+/*
+ * SmartCool Parasol - 단계별 실행 시간 계측
+ *
+ * 센싱/모드 판단/파라솔/펌프/보고 단계를 micros()로 재서
+ * 단계마다 최소/최대/평균과 로그 구간 히스토그램을 남긴다.
+ * 제어 루프 호출 간격(지터)과 간격이 예산을 넘은 횟수도 함께 센다.
+ *
+ * 히스토그램은 구간당 1바이트. 한 구간이 255에 닿으면 전체를 반으로 줄여
+ * 분포 모양은 유지한다. 단계 하나에 20바이트 남짓.
+ *
+ * 릴리즈 빌드(-DSMARTCOOL_RELEASE)에서는 PROFILE_SCOPE가 빈 매크로가 되고
+ * 이 모듈의 코드/SRAM은 전혀 링크되지 않는다.
+ */
+
+#ifndef SMARTCOOL_PROFILER_H
+#define SMARTCOOL_PROFILER_H
+
+#include <stdint.h>
+#include "Hal.h"
+
+#ifndef PROFILE_ENABLED
+#ifdef SMARTCOOL_RELEASE
+#define PROFILE_ENABLED 0
+#else
+#define PROFILE_ENABLED 1
+#endif
+#endif
+
+enum ProfileStage {
+    STAGE_SENSE,        // readAllSensors
+    STAGE_MODE,         // updateSystemMode
+    STAGE_PARASOL,      // controlParasol
+    STAGE_PUMP,         // controlWaterPump
+    STAGE_REPORT,       // 상태 보고 (텍스트 한 줄 또는 텔레메트리 프레임)
+    STAGE_LOOP,         // controlTick() 호출 간격
+    STAGE_COUNT
+};
+
+// 구간 b의 상한은 16 << b us, 마지막 구간은 그 이상 전부
+const uint8_t PROFILE_BUCKETS = 10;
+
+// 루프 호출 간격이 이보다 길면 지터 초과로 센다 (가장 짧은 태스크 마감, 5ms)
+const unsigned long PROFILE_LOOP_BUDGET_US = 5000;
+
+struct StageStats {
+    uint16_t count;             // 65535에서 멈춤
+    uint16_t minUs;             // 65535us 이상은 65535로
+    uint16_t maxUs;
+    uint32_t totalUs;           // 평균 = totalUs / count
+    uint8_t buckets[PROFILE_BUCKETS];
+};
+
+#if PROFILE_ENABLED
+
+void profileRecord(uint8_t stage, unsigned long us);
+void profileLoopTick();     // controlTick()마다 호출
+void profileReset();
+
+const StageStats& profileStage(uint8_t stage);
+uint16_t profileMeanUs(uint8_t stage);
+uint16_t profileLoopOverruns();
+
+inline unsigned long profileBucketLimitUs(uint8_t bucket) { return 16UL << bucket; }
+
+// 스코프를 벗어날 때 경과 시간을 기록
+class ProfileScope {
+public:
+    explicit ProfileScope(uint8_t stage) : stage(stage), start(hal::micros()) {}
+    ~ProfileScope() { profileRecord(stage, hal::micros() - start); }
+
+private:
+    uint8_t stage;
+    unsigned long start;
+};
+
+#define PROFILE_SCOPE(stage) ProfileScope profileScope_(stage)
+#define PROFILE_LOOP_TICK() profileLoopTick()
+
+#else
+
+#define PROFILE_SCOPE(stage) ((void)0)
+#define PROFILE_LOOP_TICK() ((void)0)
+
+#endif
+
+#endif
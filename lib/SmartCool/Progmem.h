@@ -0,0 +1,29 @@
+/*
+ * SmartCool Parasol - 플래시(PROGMEM) 상수 접근
+ * AVR에서는 avr/pgmspace.h 그대로, 네이티브에서는 일반 메모리 읽기로 대체한다.
+ */
+
+#ifndef SMARTCOOL_PROGMEM_H
+#define SMARTCOOL_PROGMEM_H
+
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#else
+#include <string.h>
+#include <stdint.h>
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define PSTR(s) (s)
+
+// Arduino의 F("...") 플래시 문자열 흉내 (타입만 구분, 실제로는 RAM)
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+#endif
+
+#endif
@@ -0,0 +1,59 @@
+/*
+ * SmartCool Parasol - 단일 생산자/단일 소비자(SPSC) 락프리 링 버퍼
+ *
+ * 생산자(ISR)는 head만, 소비자(메인 루프)는 tail만 갱신한다.
+ * 인덱스가 uint8_t라 AVR에서 읽기/쓰기가 원자적이므로 인터럽트 차단이 필요 없다.
+ * N은 2의 거듭제곱, 2~128 (uint8_t 템플릿 인자). 실제 저장 가능 개수는 N - 1.
+ */
+
+#ifndef SMARTCOOL_RING_BUFFER_H
+#define SMARTCOOL_RING_BUFFER_H
+
+#include <stdint.h>
+
+template <typename T, uint8_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of two");
+    static_assert(N <= 128, "N must fit uint8_t: power of two up to 128");
+
+public:
+    SpscRing() : head(0), tail(0), dropped(0) {}
+
+    // 생산자 전용. 가득 차면 버리고 false
+    bool push(const T& item) {
+        uint8_t h = head;
+        uint8_t next = (uint8_t)(h + 1) & MASK;
+        if (next == tail) {
+            dropped++;
+            return false;
+        }
+        items[h] = item;
+        head = next;
+        return true;
+    }
+
+    // 소비자 전용. 비어 있으면 false
+    bool pop(T& item) {
+        uint8_t t = tail;
+        if (t == head) return false;
+        item = items[t];
+        tail = (uint8_t)(t + 1) & MASK;
+        return true;
+    }
+
+    bool empty() const { return head == tail; }
+    uint8_t size() const { return (uint8_t)(head - tail) & MASK; }
+
+    // 생산자 쪽에서만 증가. 소비자는 읽기만 한다
+    uint16_t droppedCount() const { return dropped; }
+
+private:
+    static const uint8_t MASK = N - 1;
+
+    T items[N];
+    volatile uint8_t head;
+    volatile uint8_t tail;
+    volatile uint16_t dropped;
+};
+
+#endif
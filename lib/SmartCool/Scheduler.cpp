@@ -0,0 +1,95 @@
+#include "Scheduler.h"
+
+Scheduler::Scheduler(Task* tasks, uint8_t count, ClockFunction clock)
+    : tasks(tasks), count(count), clock(clock) {
+}
+
+void Scheduler::begin() {
+    unsigned long now = clock();
+    for (uint8_t i = 0; i < count; i++) {
+        tasks[i].nextRelease = now;
+        tasks[i].released = false;
+        tasks[i].overruns = 0;
+        tasks[i].runs = 0;
+    }
+}
+
+void Scheduler::releaseDue(unsigned long now) {
+    for (uint8_t i = 0; i < count; i++) {
+        Task& t = tasks[i];
+        if ((long)(now - t.nextRelease) < 0) continue;
+
+        if (!t.released) {
+            t.released = true;
+            t.releaseTime = t.nextRelease;
+        }
+        t.nextRelease += t.periodMs;
+
+        // 한 주기 이상 밀렸으면 따라잡지 않고 현재 시각 기준으로 재정렬
+        if ((long)(now - t.nextRelease) >= 0) {
+            t.nextRelease = now + t.periodMs;
+        }
+    }
+}
+
+bool Scheduler::runOnce() {
+    unsigned long now = clock();
+    releaseDue(now);
+
+    // 릴리즈된 태스크 중 절대 마감시간이 가장 빠른 것 선택 (EDF)
+    int8_t selected = -1;
+    long earliest = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        const Task& t = tasks[i];
+        if (!t.released) continue;
+        long slack = (long)(t.releaseTime + t.deadlineMs - now);
+        if (selected < 0 || slack < earliest) {
+            selected = i;
+            earliest = slack;
+        }
+    }
+    if (selected < 0) return false;
+
+    Task& t = tasks[selected];
+    t.released = false;
+    t.run();
+    t.runs++;
+
+    if (clock() - t.releaseTime > t.deadlineMs) {
+        t.overruns++;
+    }
+    return true;
+}
+
+void Scheduler::trigger(uint8_t id) {
+    if (id >= count) return;
+    Task& t = tasks[id];
+    if (!t.released) {
+        t.released = true;
+        t.releaseTime = clock();
+    }
+}
+
+void Scheduler::resync() {
+    unsigned long now = clock();
+    for (uint8_t i = 0; i < count; i++) {
+        Task& t = tasks[i];
+        if ((long)(now - t.nextRelease) > 0) t.nextRelease = now;
+        if (t.released && (long)(now - t.releaseTime) > 0) t.releaseTime = now;
+    }
+}
+
+unsigned long Scheduler::nextReleaseTime() const {
+    unsigned long now = clock();
+    unsigned long next = now;
+    bool first = true;
+    for (uint8_t i = 0; i < count; i++) {
+        const Task& t = tasks[i];
+        if (t.released) return now;
+        if (first || (long)(t.nextRelease - next) < 0) {
+            next = t.nextRelease;
+            first = false;
+        }
+    }
+    return next;
+}
@@ -0,0 +1,65 @@
+/*
+ * SmartCool Parasol - 협조적(cooperative) 태스크 스케줄러
+ *
+ * 각 태스크는 주기(period)와 상대 마감시간(deadline)을 가진다.
+ * 태스크 함수는 절대 블로킹하지 않고 짧게 끝나야 하며,
+ * 릴리즈된 태스크 중 절대 마감시간이 가장 빠른 것부터 실행한다(EDF).
+ * trigger()로 이벤트 발생 시 주기를 기다리지 않고 즉시 릴리즈할 수 있다.
+ */
+
+#ifndef SMARTCOOL_SCHEDULER_H
+#define SMARTCOOL_SCHEDULER_H
+
+#include <stdint.h>
+
+typedef void (*TaskFunction)();
+typedef unsigned long (*ClockFunction)();
+
+struct Task {
+    TaskFunction run;
+    unsigned long periodMs;
+    unsigned long deadlineMs;   // 릴리즈 후 이 시간 안에 실행이 끝나야 함
+
+    // 스케줄러 내부 상태
+    unsigned long nextRelease;
+    unsigned long releaseTime;
+    bool released;
+    uint16_t overruns;          // 마감 초과 횟수
+    uint16_t runs;              // 실행 횟수
+};
+
+// 태스크 테이블 초기화용 (run, 주기, 마감)
+#define SCHEDULER_TASK(fn, periodMs, deadlineMs) \
+    { fn, periodMs, deadlineMs, 0, 0, false, 0, 0 }
+
+class Scheduler {
+public:
+    Scheduler(Task* tasks, uint8_t count, ClockFunction clock);
+
+    // 모든 태스크를 now 기준으로 즉시 릴리즈 상태로 시작
+    void begin();
+
+    // 준비된 태스크 하나를 실행. 실행했으면 true
+    bool runOnce();
+
+    // 이벤트 릴리즈: 다음 주기를 기다리지 않고 바로 실행 대기열에 올림
+    void trigger(uint8_t id);
+
+    // 시계를 건너뛴 뒤(시뮬레이션) 밀린 릴리즈를 마감 초과로 세지 않고 현재 시각에 맞춤
+    void resync();
+
+    // 가장 가까운 다음 릴리즈 시각 (대기 중 태스크가 있으면 현재 시각)
+    unsigned long nextReleaseTime() const;
+
+    const Task& task(uint8_t id) const { return tasks[id]; }
+    uint8_t taskCount() const { return count; }
+
+private:
+    void releaseDue(unsigned long now);
+
+    Task* tasks;
+    uint8_t count;
+    ClockFunction clock;
+};
+
+#endif
@@ -0,0 +1,148 @@
+#include "SelfTest.h"
+#include "Actuators.h"
+#include "ControlCore.h"
+#include "EepromLayout.h"
+#include "Hal.h"
+#include "Telemetry.h"
+
+static const uint8_t RECORD_BYTES = SELF_TEST_RECORD_BYTES - 2;
+static_assert(SELF_TEST_RECORD_BYTES <= EEPROM_SELF_TEST_SIZE, "self-test record does not fit its EEPROM slot");
+
+// 예전 부팅 테스트와 같은 순서
+static const uint8_t SWEEP[] = { ANGLE_STOWED, ANGLE_SHADE, ANGLE_COLLECT, ANGLE_SHADE, ANGLE_STOWED };
+static const uint8_t SWEEP_COUNT = sizeof(SWEEP);
+
+SelfTest selfTest;
+
+bool loadSelfTestRecord(SelfTestRecord& record) {
+    uint8_t bytes[RECORD_BYTES + 2];
+    for (uint8_t i = 0; i < sizeof(bytes); i++) bytes[i] = hal::eepromRead(EEPROM_SELF_TEST_ADDR + i);
+
+    uint16_t crc = (uint16_t)(bytes[RECORD_BYTES] | (bytes[RECORD_BYTES + 1] << 8));
+    if (crc16Ccitt(bytes, RECORD_BYTES) != crc || bytes[0] != SELF_TEST_VERSION) return false;
+
+    record.version = bytes[0];
+    record.result = bytes[1];
+    record.runs = (uint16_t)(bytes[2] | (bytes[3] << 8));
+    record.sweepMs = (uint16_t)(bytes[4] | (bytes[5] << 8));
+    return true;
+}
+
+void encodeSelfTestRecord(const SelfTestRecord& record, uint8_t* bytes) {
+    bytes[0] = record.version;
+    bytes[1] = record.result;
+    bytes[2] = (uint8_t)record.runs;
+    bytes[3] = (uint8_t)(record.runs >> 8);
+    bytes[4] = (uint8_t)record.sweepMs;
+    bytes[5] = (uint8_t)(record.sweepMs >> 8);
+    uint16_t crc = crc16Ccitt(bytes, RECORD_BYTES);
+    bytes[RECORD_BYTES] = (uint8_t)crc;
+    bytes[RECORD_BYTES + 1] = (uint8_t)(crc >> 8);
+}
+
+// 같은 값인 바이트는 eepromWrite()가 건너뛴다. 보통 runs/sweepMs/CRC 몇 바이트만 쓰인다
+void saveSelfTestRecord(const SelfTestRecord& record) {
+    uint8_t bytes[SELF_TEST_RECORD_BYTES];
+    encodeSelfTestRecord(record, bytes);
+    for (uint8_t i = 0; i < SELF_TEST_RECORD_BYTES; i++) hal::eepromWrite(EEPROM_SELF_TEST_ADDR + i, bytes[i]);
+}
+
+SelfTest::SelfTest()
+    : stage(STAGE_WAIT), sweepIndex(0), passed(0), saveIndex(SELF_TEST_RECORD_BYTES), fromCache(false),
+      stageAt(0), sweepStartedAt(0), last() {
+}
+
+bool SelfTest::begin() {
+    stage = STAGE_WAIT;
+    passed = 0;
+    saveIndex = SELF_TEST_RECORD_BYTES;
+    fromCache = loadSelfTestRecord(last);
+    if (!fromCache) last = SelfTestRecord();
+
+    // 지난 진단이 모두 통과였으면 진단을 기다리지 않고 바로 제어
+    status.systemReady = fromCache && last.result == SELFTEST_ALL;
+    return status.systemReady;
+}
+
+SelfTestEvent SelfTest::poll() {
+    if (saving()) saveStep();
+    unsigned long now = hal::millis();
+
+    // 제어가 모드를 바꿨으면 (systemReady일 때만 가능) 액추에이터를 돌려준다
+    if (running() && status.operationMode != MODE_STANDBY) return abort();
+
+    switch (stage) {
+    case STAGE_WAIT:
+        if (status.operationMode != MODE_STANDBY || parasolMotion.moving()) break;
+        holdActuators(true);
+        passed = 0;
+        stage = STAGE_SENSORS;
+        stageAt = now;
+        break;
+
+    case STAGE_SENSORS:
+        if (!sensors.isValid && now - stageAt < SELF_TEST_SENSOR_TIMEOUT_MS) break;
+        if (sensors.isValid) passed |= SELFTEST_SENSORS;
+        sweepIndex = 0;
+        sweepStartedAt = now;
+        actuators.commandParasol(SWEEP[0]);
+        stage = STAGE_SERVO;
+        return SELFTEST_EVENT_SENSORS;
+
+    case STAGE_SERVO:
+        if (parasolMotion.moving()) break;
+        if (++sweepIndex < SWEEP_COUNT) {
+            actuators.commandParasol(SWEEP[sweepIndex]);
+            break;
+        }
+        last.sweepMs = (uint16_t)(now - sweepStartedAt);
+        passed |= SELFTEST_SERVO;
+        relayON();
+        stage = STAGE_RELAY;
+        stageAt = now;
+        return SELFTEST_EVENT_SERVO;
+
+    case STAGE_RELAY:
+        if (now - stageAt < SELF_TEST_RELAY_PULSE_MS) break;
+        relayOFF();
+        passed |= SELFTEST_RELAY;
+        return finish();
+
+    case STAGE_DONE:
+        break;
+    }
+    return SELFTEST_EVENT_NONE;
+}
+
+SelfTestEvent SelfTest::abort() {
+    // 릴레이 단계였다면 비 모드의 controlWaterPump가 끄지만, 확실히 해 둔다
+    if (stage == STAGE_RELAY && status.operationMode != MODE_HEAT) relayOFF();
+    holdActuators(false);
+    scheduler.trigger(TASK_ACTUATE);
+    stage = STAGE_WAIT;
+    return SELFTEST_EVENT_ABORTED;
+}
+
+SelfTestEvent SelfTest::finish() {
+    holdActuators(false);
+    scheduler.trigger(TASK_ACTUATE);
+
+    last.version = SELF_TEST_VERSION;
+    last.result = passed;
+    if (last.runs < 0xFFFF) last.runs++;
+    saveIndex = 0;      // 다음 poll()부터 EEPROM이 준비될 때마다 한 바이트씩
+
+    status.systemReady = true;
+    stage = STAGE_DONE;
+    return SELFTEST_EVENT_COMPLETE;
+}
+
+// 바뀐 바이트 하나에 약 3.4ms라 한 번에 다 쓰면 최대 27ms 동안 루프가 선다.
+// CRC가 마지막 두 바이트라 다 쓰기 전에 전원이 나가면 기록 없음으로 읽힌다 (다음 부팅에 다시 진단)
+void SelfTest::saveStep() {
+    if (!hal::eepromReady()) return;
+    uint8_t bytes[SELF_TEST_RECORD_BYTES];
+    encodeSelfTestRecord(last, bytes);
+    hal::eepromWrite(EEPROM_SELF_TEST_ADDR + saveIndex, bytes[saveIndex]);
+    saveIndex++;
+}
@@ -0,0 +1,105 @@
+/*
+ * SmartCool Parasol - 빠른 부팅과 백그라운드 자가 진단
+ *
+ * 예전 부팅은 서보 5구간 왕복과 릴레이 펄스를 블로킹으로 돌려 약 6.5초 동안
+ * 파라솔을 제어하지 않았다. 브라운아웃/워치독 리셋마다 그만큼 무방비였다.
+ *
+ * 이제 부팅은 안전 상태(수납, 펌프 OFF)만 만들고 바로 제어를 시작한다.
+ * 마지막 자가 진단 결과를 EEPROM에 CRC와 함께 두고, 모든 항목이 통과였으면
+ * systemReady를 즉시 켠다. 진단 자체는 제어 틱 사이에 poll()이 한 단계씩 진행한다.
+ *
+ *   1. 센서: 모든 채널이 신선도 마감 안에 값을 내는지
+ *   2. 서보: 수납 → 차양 → 수집 → 차양 → 수납 (motionTask가 램프로 구동)
+ *   3. 릴레이: 0.5초 펄스
+ *
+ * 진단은 대기 모드에서 파라솔이 멈춰 있을 때만 액추에이터를 잡는다. 그 사이 비/더위로
+ * 모드가 바뀌면 제어가 바로 되찾고 진단은 처음부터 다시 기다린다.
+ * 캐시가 없거나 깨졌으면 예전처럼 진단이 끝나야 systemReady가 켜진다 (블로킹 없이).
+ */
+
+#ifndef SMARTCOOL_SELF_TEST_H
+#define SMARTCOOL_SELF_TEST_H
+
+#include <stdint.h>
+
+enum SelfTestItem : uint8_t {
+    SELFTEST_SENSORS = 0x01,
+    SELFTEST_SERVO = 0x02,
+    SELFTEST_RELAY = 0x04,
+    SELFTEST_ALL = 0x07
+};
+
+enum SelfTestEvent : uint8_t {
+    SELFTEST_EVENT_NONE,
+    SELFTEST_EVENT_SENSORS,     // 센서 단계 끝 (통과 여부는 result())
+    SELFTEST_EVENT_SERVO,       // 서보 왕복 끝
+    SELFTEST_EVENT_COMPLETE,    // 전체 끝. EEPROM 갱신은 이어지는 poll()이 한 바이트씩
+    SELFTEST_EVENT_ABORTED      // 모드가 바뀌어 제어에 양보
+};
+
+const uint8_t SELF_TEST_VERSION = 1;
+const uint16_t SELF_TEST_SENSOR_TIMEOUT_MS = 3000;
+const uint16_t SELF_TEST_RELAY_PULSE_MS = 500;
+
+// EEPROM 캐시 (EEPROM_SELF_TEST_ADDR, 뒤에 CRC16 2바이트)
+struct SelfTestRecord {
+    uint8_t version;
+    uint8_t result;         // 통과한 SelfTestItem 비트
+    uint16_t runs;          // 끝까지 돈 진단 횟수
+    uint16_t sweepMs;       // 서보 왕복에 걸린 시간
+};
+
+// 기록 6바이트 + CRC16
+const uint8_t SELF_TEST_RECORD_BYTES = 8;
+
+bool loadSelfTestRecord(SelfTestRecord& record);
+void encodeSelfTestRecord(const SelfTestRecord& record, uint8_t* bytes);
+
+// 한 번에 다 쓴다 (바뀐 바이트마다 약 3.4ms 대기). 제어 루프 밖(테스트, 공장 초기화)에서만
+void saveSelfTestRecord(const SelfTestRecord& record);
+
+class SelfTest {
+public:
+    SelfTest();
+
+    // 캐시를 읽어 systemReady를 정하고 진단을 예약한다. 캐시가 모두 통과면 true
+    bool begin();
+
+    // 메인 루프에서 controlTick()과 번갈아 호출. 블로킹 없음
+    SelfTestEvent poll();
+
+    bool cached() const { return fromCache; }
+    bool running() const { return stage != STAGE_WAIT && stage != STAGE_DONE; }
+    bool done() const { return stage == STAGE_DONE; }
+    bool saving() const { return saveIndex < SELF_TEST_RECORD_BYTES; }
+    uint8_t result() const { return passed; }
+
+    // 마지막으로 끝난 진단 (부팅 직후에는 캐시 값)
+    const SelfTestRecord& record() const { return last; }
+
+private:
+    enum Stage : uint8_t {
+        STAGE_WAIT,         // 대기 모드 + 파라솔 정지를 기다림
+        STAGE_SENSORS,
+        STAGE_SERVO,
+        STAGE_RELAY,
+        STAGE_DONE
+    };
+
+    SelfTestEvent abort();
+    SelfTestEvent finish();
+    void saveStep();
+
+    Stage stage;
+    uint8_t sweepIndex;
+    uint8_t passed;
+    uint8_t saveIndex;      // 다음에 쓸 기록 바이트 (SELF_TEST_RECORD_BYTES면 쓸 것 없음)
+    bool fromCache;
+    unsigned long stageAt;
+    unsigned long sweepStartedAt;
+    SelfTestRecord last;
+};
+
+extern SelfTest selfTest;
+
+#endif
@@ -0,0 +1,158 @@
+/*
+ * SmartCool Parasol - 정수 전용 센서 변환
+ *
+ * ADC 원시값 → Q8.8 값 변환은 컴파일 타임에 계산한 배율(×65536)을 곱하고
+ * 시프트하는 것으로 끝난다. 런타임 나눗셈이나 float 루틴이 필요 없다.
+ * 임계값 비교는 물리 단위가 아니라 ADC 원시값끼리 한다.
+ */
+
+#ifndef SMARTCOOL_SENSOR_CONVERSION_H
+#define SMARTCOOL_SENSOR_CONVERSION_H
+
+#include <stdint.h>
+#include "FixedPoint.h"
+#include "Ky013Table.h"
+#include "Progmem.h"
+
+const uint16_t ADC_MAX = 1023;
+
+// [lo, hi] 원시값 구간을 [0, fullQ] Q8.8 값으로 선형 매핑
+struct LinearScale {
+    uint16_t lo;
+    uint16_t hi;
+    uint16_t fullQ;
+    uint32_t factor;    // fullQ × 65536 / (hi - lo)
+
+    uint16_t apply(uint16_t raw) const {
+        if (raw <= lo) return 0;
+        if (raw >= hi) return fullQ;
+        return (uint16_t)(((uint32_t)(raw - lo) * factor) >> 16);
+    }
+};
+
+constexpr LinearScale makeLinearScale(uint16_t lo, uint16_t hi, uint16_t fullQ) {
+    return LinearScale{ lo, hi, fullQ, ((uint32_t)fullQ << 16) / (uint32_t)(hi - lo) };
+}
+
+// ============= 포텐셔미터 온도 (0 ~ 40°C) =============
+const uint8_t POT_TEMP_RANGE_C = 40;
+constexpr LinearScale POT_TEMP_SCALE = makeLinearScale(0, ADC_MAX, POT_TEMP_RANGE_C * Q_ONE);
+
+inline Celsius potentiometerToCelsius(uint16_t raw) {
+    return Celsius::fromQ((int16_t)POT_TEMP_SCALE.apply(raw));
+}
+
+// "온도 > c" 와 같은 조건이 되는 원시값 경계 (raw > 반환값 이면 초과).
+// c는 컴파일 타임 상수로만 사용하므로 float 루틴이 링크되지 않는다.
+constexpr uint16_t potRawForCelsius(float c) {
+    return (uint16_t)(c * ADC_MAX / POT_TEMP_RANGE_C);
+}
+
+// 런타임용 같은 경계 (보정값이 바뀔 때만, 정수 나눗셈 한 번)
+inline uint16_t potRawForQ(int16_t q) {
+    if (q <= 0) return 0;
+    uint32_t raw = (uint32_t)q * ADC_MAX / ((uint32_t)POT_TEMP_RANGE_C * Q_ONE);
+    return raw > ADC_MAX ? ADC_MAX : (uint16_t)raw;
+}
+
+// ============= KY-013 NTC (플래시 표 + 정수 보간) =============
+// NTC는 선형이 아니다. Steinhart-Hart(log, 소프트 float)를 매 샘플 돌리는 대신
+// 빌드 때 만든 16 원시값 간격 표(Ky013Table.h)에서 두 점을 읽어 선형 보간한다.
+// 0 ~ 60°C에서 식과의 차이 0.05°C 이내, 플래시 130바이트
+
+// 두 표 값 사이 frac/16 지점 (컴파일 타임/런타임 공용)
+constexpr int16_t ky013Interpolate(int16_t lo, int16_t hi, uint8_t frac) {
+    return (int16_t)(lo + ((((int32_t)hi - lo) * frac) >> KY013_TABLE_SHIFT));
+}
+
+inline Celsius ky013ToCelsius(uint16_t raw) {
+    if (raw > ADC_MAX) raw = ADC_MAX;
+    uint8_t i = (uint8_t)(raw >> KY013_TABLE_SHIFT);
+    uint8_t frac = (uint8_t)(raw & ((1 << KY013_TABLE_SHIFT) - 1));
+    int16_t lo = (int16_t)pgm_read_word(&KY013_TABLE[i]);
+    int16_t hi = (int16_t)pgm_read_word(&KY013_TABLE[i + 1]);
+    return Celsius::fromQ(ky013Interpolate(lo, hi, frac));
+}
+
+// 컴파일 타임 전용: 표를 직접 읽어 같은 보간
+constexpr int16_t ky013TableQ(uint16_t raw) {
+    return ky013Interpolate(KY013_TABLE[raw >> KY013_TABLE_SHIFT],
+                            KY013_TABLE[(raw >> KY013_TABLE_SHIFT) + 1],
+                            (uint8_t)(raw & ((1 << KY013_TABLE_SHIFT) - 1)));
+}
+
+// [lo, hi]에서 온도가 q 이하인 가장 큰 원시값 (표는 원시값에 대해 증가)
+constexpr uint16_t ky013RawAtMost(int32_t q, uint16_t lo, uint16_t hi) {
+    return lo >= hi ? lo
+         : ky013TableQ((uint16_t)((lo + hi + 1) / 2)) <= q
+               ? ky013RawAtMost(q, (uint16_t)((lo + hi + 1) / 2), hi)
+               : ky013RawAtMost(q, lo, (uint16_t)((lo + hi + 1) / 2 - 1));
+}
+
+// potRawForCelsius와 같은 뜻: raw > 반환값 이면 c 초과
+constexpr uint16_t ky013RawForCelsius(float c) {
+    return ky013RawAtMost((int32_t)(c * Q_ONE), 0, ADC_MAX);
+}
+
+// 런타임용 같은 탐색 (플래시 표 10번 읽기)
+inline uint16_t ky013RawForQ(int16_t q) {
+    uint16_t lo = 0;
+    uint16_t hi = ADC_MAX;
+    while (lo < hi) {
+        uint16_t mid = (uint16_t)((lo + hi + 1) / 2);
+        if (ky013ToCelsius(mid).q <= q) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return lo;
+}
+
+// ============= 체감 온도 (온도 + 습도) =============
+// Steadman 체감 온도 (그늘, 바람 없음): AT = T + 0.33·e − 4.0, e = RH/100 × es(T) [hPa]
+// 포화 수증기압 es(T)는 Magnus 식 6.105·exp(17.27T / (237.7 + T))를
+// 0 ~ 50°C 1도 간격 표(hPa × 10, 플래시 102바이트)로 두고 보간한다.
+// 28°C 기준으로 습도 32%면 AT ≈ T, 60%면 약 +3.5°C, 20%면 약 −1.5°C
+const uint8_t VAPOR_TABLE_MAX_C = 50;
+
+const uint16_t SATURATION_VAPOR_TENTHS[VAPOR_TABLE_MAX_C + 1] PROGMEM = {
+      61,   66,   71,   76,   81,   87,   93,  100,  107,  115,  // 0°C~
+     123,  131,  140,  149,  160,  170,  181,  193,  206,  219,  // 10°C~
+     233,  248,  264,  280,  298,  316,  335,  355,  377,  399,  // 20°C~
+     423,  448,  474,  501,  530,  560,  592,  625,  660,  696,  // 30°C~
+     735,  775,  816,  860,  906,  954, 1004, 1057, 1111, 1168,  // 40°C~
+    1228,
+};
+
+inline Celsius apparentTemperature(Celsius t, Percent rh) {
+    // 표 범위 밖은 끝값 (에어컨 판단 범위는 한참 안쪽)
+    int16_t q = t.q;
+    if (q < 0) q = 0;
+    if (q >= VAPOR_TABLE_MAX_C * Q_ONE) q = VAPOR_TABLE_MAX_C * Q_ONE - 1;
+    uint8_t i = (uint8_t)(q >> Q_SHIFT);
+    uint8_t frac = (uint8_t)q;
+    uint16_t lo = pgm_read_word(&SATURATION_VAPOR_TENTHS[i]);
+    uint16_t hi = pgm_read_word(&SATURATION_VAPOR_TENTHS[i + 1]);
+    uint16_t es = (uint16_t)(lo + (((uint32_t)(hi - lo) * frac) >> Q_SHIFT));
+
+    // 0.33 × es/10 × RH.q/(100×256) °C를 Q8.8로: es × RH.q / 3030.3
+    // = ((es × RH.q) >> 12) × 173 >> 7  (나눗셈 없이, 32비트 안에서)
+    uint32_t vapor = ((uint32_t)es * rh.q) >> 12;
+    int16_t offset = (int16_t)((vapor * 173) >> 7);
+
+    // KY-013 표 끝(127.99°C, NTC 단락 등)에 습도가 붙으면 16비트를 넘는다.
+    // 음수로 감기면 더위 모드가 영영 안 켜지므로 끝값으로 묶는다
+    // (avr-libc는 C++에서 INT16_MAX를 정의하지 않으므로 숫자로)
+    int32_t at = (int32_t)t.q + offset - 4 * Q_ONE;
+    if (at > 32767) at = 32767;
+    if (at < -32768) at = -32768;
+    return Celsius::fromQ((int16_t)at);
+}
+
+// ============= 수위 (%) =============
+inline Percent waterLevelToPercent(uint16_t raw, const LinearScale& scale) {
+    return Percent::fromQ(scale.apply(raw));
+}
+
+#endif
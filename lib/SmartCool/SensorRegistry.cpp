@@ -0,0 +1,54 @@
+#include "SensorRegistry.h"
+
+SensorRegistry::SensorRegistry(SensorChannel* channels, uint8_t count, ClockFunction clock, SensorRead read)
+    : channels(channels), count(count), clock(clock), read(read) {
+}
+
+void SensorRegistry::begin() {
+    unsigned long now = clock();
+    for (uint8_t i = 0; i < count; i++) {
+        SensorChannel& c = channels[i];
+        c.nextSample = now;
+        c.updatedAt = now;
+        c.value = 0;
+        c.samples = 0;
+        c.valid = false;
+    }
+}
+
+uint8_t SensorRegistry::poll() {
+    unsigned long now = clock();
+    uint8_t updated = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        SensorChannel& c = channels[i];
+        if ((long)(now - c.nextSample) < 0) continue;
+
+        uint16_t raw;
+        if (!read(c.source, raw)) continue;
+
+        c.value = c.filter ? c.filter(raw) : raw;
+        c.updatedAt = now;
+        c.valid = true;
+        if (c.samples < 0xFFFF) c.samples++;
+        updated |= (uint8_t)(1 << i);
+
+        // 한 주기 이상 밀렸으면 따라잡지 않고 현재 시각 기준으로 재정렬 (스케줄러와 같은 규칙)
+        c.nextSample += c.periodMs;
+        if ((long)(now - c.nextSample) >= 0) c.nextSample = now + c.periodMs;
+    }
+    return updated;
+}
+
+bool SensorRegistry::fresh(uint8_t id) const {
+    const SensorChannel& c = channels[id];
+    return c.valid && clock() - c.updatedAt <= c.staleMs;
+}
+
+uint8_t SensorRegistry::staleMask() const {
+    uint8_t mask = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        if (!fresh(i)) mask |= (uint8_t)(1 << i);
+    }
+    return mask;
+}
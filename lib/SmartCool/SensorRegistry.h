@@ -0,0 +1,70 @@
+/*
+ * SmartCool Parasol - 채널별 주기 센서 레지스트리
+ *
+ * 센서마다 동특성이 다르다. 비는 수십 ms 안에 잡아야 하고, 온도는 수 초,
+ * 물탱크 수위는 분 단위로 변한다. 채널마다 샘플링 주기, 필터, 신선도 마감
+ * (이 시간 넘게 새 값이 없으면 stale)을 따로 두고, 주기가 된 채널만 읽는다.
+ * 빠른 채널은 느린 채널을 기다리지 않는다.
+ *
+ * poll()은 센싱 태스크에서 부른다. 태스크 주기는 가장 빠른 채널 주기 이하로 둔다.
+ * 읽기 함수가 false를 돌려주면(ADC 블록 미완성 등) 그 채널은 다음 poll에 다시 본다.
+ */
+
+#ifndef SMARTCOOL_SENSOR_REGISTRY_H
+#define SMARTCOOL_SENSOR_REGISTRY_H
+
+#include <stdint.h>
+#include "Scheduler.h"
+
+// 원시값 하나를 필터에 넣고 필터 출력을 반환 (NULL이면 원시값 그대로)
+typedef uint16_t (*SensorFilter)(uint16_t raw);
+
+// 원시값 읽기. 아직 값이 없으면 false
+typedef bool (*SensorRead)(uint8_t source, uint16_t& raw);
+
+struct SensorChannel {
+    uint8_t source;             // 읽기 함수에 넘기는 번호 (ADC 슬롯)
+    SensorFilter filter;
+    uint16_t periodMs;
+    uint16_t staleMs;           // 마지막 갱신 후 이 시간이 지나면 stale
+
+    // 레지스트리 내부 상태
+    unsigned long nextSample;
+    unsigned long updatedAt;
+    uint16_t value;             // 필터 출력
+    uint16_t samples;           // 65535에서 멈춤
+    bool valid;                 // 값이 한 번이라도 들어왔는지
+};
+
+// 채널 테이블 초기화용 (source, 필터, 주기, 신선도 마감)
+#define SENSOR_CHANNEL(source, filter, periodMs, staleMs) \
+    { source, filter, periodMs, staleMs, 0, 0, 0, 0, false }
+
+class SensorRegistry {
+public:
+    SensorRegistry(SensorChannel* channels, uint8_t count, ClockFunction clock, SensorRead read);
+
+    // 모든 채널을 값 없음 상태로, 바로 샘플링 대상으로
+    void begin();
+
+    // 주기가 된 채널을 읽어 필터에 넣는다. 이번에 갱신된 채널의 비트마스크 반환
+    uint8_t poll();
+
+    uint16_t value(uint8_t id) const { return channels[id].value; }
+    bool fresh(uint8_t id) const;
+    bool allFresh() const { return staleMask() == 0; }
+
+    // 값이 없거나 신선도 마감을 넘긴 채널의 비트마스크
+    uint8_t staleMask() const;
+
+    const SensorChannel& channel(uint8_t id) const { return channels[id]; }
+    uint8_t channelCount() const { return count; }
+
+private:
+    SensorChannel* channels;
+    uint8_t count;
+    ClockFunction clock;
+    SensorRead read;
+};
+
+#endif
@@ -0,0 +1,130 @@
+#include "ServoMotion.h"
+
+namespace {
+
+int32_t absQ(int32_t v) { return v < 0 ? -v : v; }
+
+// 정수 제곱근 (도착 시간 추정용)
+uint32_t isqrt(uint32_t n) {
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+    while (bit > n) bit >>= 2;
+    while (bit) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+}
+
+ServoMotion::ServoMotion(uint16_t maxSpeed, uint16_t acceleration, uint8_t tickMs)
+    : positionQ(0), velocityQ(0), targetQ(0), startQ(0),
+      maxSpeedQ((int32_t)maxSpeed << 8),
+      deltaVQ(((int32_t)acceleration << 8) * tickMs / 1000),
+      acceleration(acceleration), tickMs(tickMs), outputAngle(0) {
+    if (deltaVQ < 1) deltaVQ = 1;
+}
+
+void ServoMotion::reset(uint8_t angle) {
+    positionQ = targetQ = startQ = (int32_t)angle << 8;
+    velocityQ = 0;
+    outputAngle = angle;
+}
+
+void ServoMotion::moveTo(uint8_t angle) {
+    int32_t q = (int32_t)angle << 8;
+    if (q == targetQ) return;
+    targetQ = q;
+    startQ = positionQ;
+}
+
+bool ServoMotion::update() {
+    int32_t distance = targetQ - positionQ;
+    if (distance == 0 && velocityQ == 0) return false;
+
+    int8_t dir = distance > 0 ? 1 : (distance < 0 ? -1 : (velocityQ > 0 ? -1 : 1));
+    int32_t toward = velocityQ * dir;   // 양수면 목표 쪽으로 이동 중
+    int32_t remaining = absQ(distance);
+
+    if (toward < 0) {
+        // 반대 방향으로 가던 중 선점됨 → 먼저 감속
+        toward += deltaVQ;
+    } else {
+        // 정지 거리 v²/2a 를 Q4 단위로 계산 (32비트 안에서)
+        uint32_t v4 = (uint32_t)toward >> 4;
+        uint32_t stopQ = ((v4 * v4) / (2UL * acceleration * 16)) << 4;
+        if (stopQ >= (uint32_t)remaining) {
+            toward -= deltaVQ;
+            if (toward < deltaVQ) toward = deltaVQ;     // 도착 전 멈추지 않도록 최저 속도 유지
+        } else {
+            toward += deltaVQ;
+            if (toward > maxSpeedQ) toward = maxSpeedQ;
+        }
+    }
+
+    int32_t step = toward * tickMs / 1000;
+    if (toward > 0 && step >= remaining) {
+        positionQ = targetQ;
+        velocityQ = 0;
+    } else {
+        velocityQ = toward * dir;
+        positionQ += step * dir;
+    }
+
+    uint8_t next = (uint8_t)((positionQ + 128) >> 8);
+    if (next == outputAngle) return false;
+    outputAngle = next;
+    return true;
+}
+
+uint8_t ServoMotion::progress() const {
+    int32_t total = absQ(targetQ - startQ);
+    if (total == 0) return 100;
+    int32_t left = absQ(targetQ - positionQ);
+    if (left >= total) return 0;
+    return (uint8_t)((total - left) * 100 / total);
+}
+
+unsigned long ServoMotion::msToArrival() const {
+    if (!moving()) return 0;
+
+    // Q4 단위: 위치 1/16도, 속도 1/16도/초, 가속도 1/16도/초²
+    int32_t distance = (targetQ - positionQ) >> 4;
+    int8_t dir = distance >= 0 ? 1 : -1;
+    uint32_t d = (uint32_t)absQ(distance);
+    int32_t v = (velocityQ >> 4) * dir;
+    uint32_t a = (uint32_t)acceleration * 16;
+    uint32_t vmax = (uint32_t)(maxSpeedQ >> 4);
+    unsigned long ms = 0;
+
+    if (v < 0) {
+        // 멈출 때까지 시간과, 그동안 멀어진 거리
+        uint32_t back = (uint32_t)(-v);
+        ms += back * 1000UL / a;
+        d += back * back / (2 * a);
+        v = 0;
+    }
+
+    uint32_t v0 = (uint32_t)v;
+    if (v0 * v0 / (2 * a) >= d) {
+        // 이미 감속 구간: 등감속으로 정지
+        return ms + (v0 ? 2UL * d * 1000UL / v0 : 0);
+    }
+
+    // 최고 속도 vp까지 가속 후 감속 (삼각형 또는 사다리꼴)
+    uint32_t vp = isqrt((2 * a * d + v0 * v0) / 2);
+    if (vp > vmax) vp = vmax;
+    uint32_t accelDist = (vp * vp - v0 * v0) / (2 * a);
+    uint32_t decelDist = vp * vp / (2 * a);
+    uint32_t cruise = d > accelDist + decelDist ? d - accelDist - decelDist : 0;
+
+    ms += (vp - v0) * 1000UL / a + vp * 1000UL / a;
+    if (vp) ms += cruise * 1000UL / vp;
+    return ms;
+}
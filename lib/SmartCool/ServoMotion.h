@@ -0,0 +1,53 @@
+/*
+ * SmartCool Parasol - 서보 모션 플래너 (사다리꼴 속도 프로파일)
+ *
+ * write(angle) 한 번으로 서보가 최고 속도로 튀어 가면 보조배터리 전류가 치솟는다.
+ * 여기서는 고정 주기 틱(update)마다 가속 → 등속 → 감속으로 명령 각도를 조금씩 옮긴다.
+ * 이동 중에 moveTo()를 다시 부르면 현재 위치/속도에서 바로 새 목표로 전환한다(선점).
+ *
+ * 내부 위치/속도는 Q8.8 (도 × 256, 도/초 × 256) 정수로 계산한다.
+ */
+
+#ifndef SMARTCOOL_SERVO_MOTION_H
+#define SMARTCOOL_SERVO_MOTION_H
+
+#include <stdint.h>
+
+class ServoMotion {
+public:
+    // maxSpeed: 도/초, acceleration: 도/초², tickMs: update() 호출 주기
+    ServoMotion(uint16_t maxSpeed, uint16_t acceleration, uint8_t tickMs);
+
+    // 현재 위치를 angle로 알고 정지 상태로 초기화
+    void reset(uint8_t angle);
+
+    // 새 목표 설정. 이동 중이면 현재 속도를 유지한 채 방향/목표를 바꾼다
+    void moveTo(uint8_t angle);
+
+    // 한 틱 진행. 서보에 보낼 명령 각도가 바뀌었으면 true
+    bool update();
+
+    uint8_t angle() const { return outputAngle; }
+    uint8_t target() const { return (uint8_t)(targetQ >> 8); }
+    bool moving() const { return velocityQ != 0 || positionQ != targetQ; }
+
+    // 현재 이동의 진행률 (0~100%)
+    uint8_t progress() const;
+
+    // 도착까지 남은 예상 시간 (ms)
+    unsigned long msToArrival() const;
+
+private:
+    int32_t positionQ;      // 도 × 256
+    int32_t velocityQ;      // 도/초 × 256 (부호 있음)
+    int32_t targetQ;
+    int32_t startQ;         // 현재 이동 시작 위치 (진행률 계산용)
+
+    int32_t maxSpeedQ;
+    int32_t deltaVQ;        // 틱당 속도 변화량
+    uint16_t acceleration;
+    uint8_t tickMs;
+    uint8_t outputAngle;
+};
+
+#endif
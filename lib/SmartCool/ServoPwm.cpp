@@ -0,0 +1,61 @@
+#include "ServoPwm.h"
+#include "Board.h"
+
+#if defined(__AVR__)
+#include <avr/io.h>
+#include <avr/power.h>
+#endif
+
+static_assert(SERVO_PIN == 9, "ServoPwm drives OC1A, the parasol servo must stay on pin 9");
+
+ServoPwm servoPwm;
+
+ServoPwm::ServoPwm() : pulse(servoPulseMicros(90)), active(false) {
+}
+
+void ServoPwm::attach() {
+#if defined(__AVR__)
+    power_timer1_enable();
+
+    // 일반 모드에서 OCR1A를 직접 써 두고 시작해야 첫 펄스부터 맞는 폭이 나간다
+    TCCR1B = 0;
+    TCCR1A = 0;
+    TIMSK1 = 0;
+    TCNT1 = 0;
+    ICR1 = (uint16_t)(SERVO_PERIOD_MICROS * SERVO_TICKS_PER_MICRO - 1);
+    OCR1A = (uint16_t)(pulse * SERVO_TICKS_PER_MICRO);
+
+    ServoPin::low();
+    ServoPin::output();
+
+    // 모드 14 fast PWM, OC1A 비반전 (BOTTOM에서 HIGH, 비교 일치에서 LOW), 분주 8
+    TCCR1A = _BV(COM1A1) | _BV(WGM11);
+    TCCR1B = _BV(WGM13) | _BV(WGM12) | _BV(CS11);
+#endif
+    active = true;
+}
+
+void ServoPwm::writeMicroseconds(uint16_t us) {
+    if (us < SERVO_MIN_MICROS) us = SERVO_MIN_MICROS;
+    if (us > SERVO_MAX_MICROS) us = SERVO_MAX_MICROS;
+    pulse = us;
+#if defined(__AVR__)
+    // Timer1 ISR이 없으므로 16비트 TEMP 레지스터를 다른 곳과 다툴 일이 없다
+    if (active) OCR1A = (uint16_t)(us * SERVO_TICKS_PER_MICRO);
+#endif
+}
+
+bool ServoPwm::detach() {
+    if (!active) return true;
+#if defined(__AVR__)
+    // 펄스 중이거나 곧 다음 주기가 시작되면 (TOP 직전 8us) 다음 기회에
+    uint16_t count = TCNT1;
+    if (count < OCR1A || count > ICR1 - 16) return false;
+
+    TCCR1A = 0;     // OC1A 분리 → PORTB1 = LOW
+    TCCR1B = 0;     // 클럭 정지
+    power_timer1_disable();
+#endif
+    active = false;
+    return true;
+}
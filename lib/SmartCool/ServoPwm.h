@@ -0,0 +1,59 @@
+/*
+ * SmartCool Parasol - Timer1 하드웨어 PWM 서보 드라이버 (핀 9 = OC1A)
+ *
+ * Timer1을 fast PWM(모드 14, TOP = ICR1)으로 두고 펄스를 하드웨어가 만든다.
+ * 분주 8이면 16MHz에서 0.5us 단위, ICR1 = 39999로 주기 20ms.
+ * 인터럽트를 하나도 쓰지 않으므로 Servo 라이브러리처럼 다른 ISR(ADC, UART)에
+ * 지터를 주지 않는다. OCR1A는 BOTTOM에서 갱신되는 이중 버퍼라 펄스 도중에
+ * 값을 바꿔도 잘린 펄스가 나가지 않는다.
+ *
+ * 파라솔이 멈춰 있을 때는 detach()로 출력을 끊고 Timer1 클럭과 전원(PRR)을 끈다.
+ * 다음 write()가 다시 붙인다.
+ *
+ * Timer1을 독점한다. Servo 라이브러리, 핀 10 analogWrite와 함께 쓸 수 없다.
+ */
+
+#ifndef SMARTCOOL_SERVO_PWM_H
+#define SMARTCOOL_SERVO_PWM_H
+
+#include <stdint.h>
+
+// 0도/180도 펄스 폭은 Servo 라이브러리 기본값과 같게 (같은 각도 = 같은 위치)
+const uint16_t SERVO_MIN_MICROS = 544;
+const uint16_t SERVO_MAX_MICROS = 2400;
+const uint16_t SERVO_PERIOD_MICROS = 20000;
+const uint8_t SERVO_TICKS_PER_MICRO = 2;    // 16MHz / 8
+
+// Servo::write()와 같은 정수 사상 (map(angle, 0, 180, 544, 2400))
+constexpr uint16_t servoPulseMicros(uint8_t angle) {
+    return angle >= 180 ? SERVO_MAX_MICROS
+         : (uint16_t)(SERVO_MIN_MICROS +
+                      (uint32_t)angle * (SERVO_MAX_MICROS - SERVO_MIN_MICROS) / 180);
+}
+
+class ServoPwm {
+public:
+    ServoPwm();
+
+    // 마지막으로 쓴 펄스 폭으로 출력 시작 (처음이면 90도)
+    void attach();
+
+    // 펄스 폭(us). SERVO_MIN/MAX_MICROS 밖은 잘라낸다. 끊긴 상태면 값만 기억
+    void writeMicroseconds(uint16_t us);
+    void write(uint8_t angle) { writeMicroseconds(servoPulseMicros(angle)); }
+
+    // 출력을 끊고 Timer1을 멈춘다. 펄스가 나가는 중이면 잘린 펄스로 서보가 튀므로
+    // 끊지 않고 false (다음 틱에 다시). 주기의 88% 이상은 LOW 구간이라 대개 바로 끊긴다
+    bool detach();
+
+    bool attached() const { return active; }
+    uint16_t pulseMicros() const { return pulse; }
+
+private:
+    uint16_t pulse;
+    bool active;
+};
+
+extern ServoPwm servoPwm;
+
+#endif
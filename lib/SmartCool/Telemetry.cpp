@@ -0,0 +1,182 @@
+#include "Telemetry.h"
+
+#include <string.h>
+
+uint16_t crc16Ccitt(const uint8_t* data, size_t length, uint16_t crc) {
+    while (length--) {
+        crc ^= (uint16_t)*data++ << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+size_t cobsEncode(const uint8_t* in, size_t length, uint8_t* out) {
+    size_t codeIndex = 0;
+    size_t write = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < length; i++) {
+        if (in[i] != 0) {
+            out[write++] = in[i];
+            code++;
+        }
+        // 0을 만났거나 블록이 254바이트로 찼으면 길이 바이트를 확정
+        if (in[i] == 0 || code == 0xFF) {
+            out[codeIndex] = code;
+            codeIndex = write++;
+            code = 1;
+        }
+    }
+    out[codeIndex] = code;
+    return write;
+}
+
+size_t cobsDecode(const uint8_t* in, size_t length, uint8_t* out) {
+    size_t read = 0;
+    size_t write = 0;
+
+    while (read < length) {
+        uint8_t code = in[read++];
+        if (code == 0 || read + code - 1 > length) return 0;
+        for (uint8_t i = 1; i < code; i++) {
+            if (in[read] == 0) return 0;
+            out[write++] = in[read++];
+        }
+        // 마지막 블록이 아니고 254바이트 꽉 찬 블록도 아니면 원래 0이 있던 자리
+        if (code != 0xFF && read < length) out[write++] = 0;
+    }
+    return write;
+}
+
+// ============= 페이로드 직렬화 (리틀엔디언 고정) =============
+static uint8_t* put16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+static uint8_t* put32(uint8_t* p, uint32_t v) {
+    p = put16(p, (uint16_t)v);
+    return put16(p, (uint16_t)(v >> 16));
+}
+
+static uint16_t get16(const uint8_t* p) {
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static uint32_t get32(const uint8_t* p) {
+    return get16(p) | ((uint32_t)get16(p + 2) << 16);
+}
+
+uint8_t encodeTelemetryFrame(const TelemetryRecord& record, uint8_t* out) {
+    uint8_t raw[TELEMETRY_RAW_SIZE];
+    uint8_t* p = raw;
+
+    *p++ = TELEMETRY_VERSION;
+    *p++ = record.type;
+    *p++ = record.sequence;
+    p = put32(p, record.uptimeMs);
+    p = put16(p, (uint16_t)record.temperatureQ);
+    p = put16(p, record.temperatureRaw);
+    p = put16(p, record.rainLevel);
+    p = put16(p, record.waterLevelRaw);
+    p = put16(p, record.waterPercentQ);
+    *p++ = record.flags;
+    *p++ = record.operationMode;
+    p = put32(p, record.lastUpdate);
+    p = put16(p, record.humidityQ);
+    p = put16(p, (uint16_t)record.heatIndexQ);
+    put16(p, crc16Ccitt(raw, TELEMETRY_PAYLOAD_SIZE));
+
+    uint8_t length = (uint8_t)cobsEncode(raw, TELEMETRY_RAW_SIZE, out);
+    out[length++] = 0;
+    return length;
+}
+
+// ============= 스트림 디코더 =============
+TelemetryDecoder::TelemetryDecoder() {
+    reset();
+}
+
+void TelemetryDecoder::reset() {
+    length = 0;
+    overflow = false;
+    haveSequence = false;
+    memset(&last, 0, sizeof(last));
+    memset(&stats, 0, sizeof(stats));
+}
+
+bool TelemetryDecoder::feed(uint8_t byte) {
+    if (byte != 0) {
+        if (length < sizeof(buffer)) {
+            buffer[length++] = byte;
+        } else {
+            overflow = true;
+        }
+        return false;
+    }
+
+    // 구분자: 빈 프레임(연속된 0x00)은 무시
+    bool ok = false;
+    if (overflow) {
+        stats.framingErrors++;
+    } else if (length > 0) {
+        ok = decode(buffer, length);
+    }
+    length = 0;
+    overflow = false;
+    return ok;
+}
+
+bool TelemetryDecoder::decode(const uint8_t* block, size_t blockLength) {
+    uint8_t raw[TELEMETRY_FRAME_MAX];
+    if (blockLength > sizeof(raw)) {
+        stats.framingErrors++;
+        return false;
+    }
+    size_t rawLength = cobsDecode(block, blockLength, raw);
+    if (rawLength < 3) {
+        stats.framingErrors++;
+        return false;
+    }
+    // CRC는 길이와 상관없이 마지막 2바이트. 버전이 다르면 길이도 다를 수 있다
+    size_t payloadLength = rawLength - 2;
+    if (crc16Ccitt(raw, payloadLength) != get16(raw + payloadLength)) {
+        stats.crcErrors++;
+        return false;
+    }
+    if (raw[0] != TELEMETRY_VERSION) {
+        stats.versionErrors++;
+        return false;
+    }
+    if (payloadLength != TELEMETRY_PAYLOAD_SIZE) {
+        stats.framingErrors++;
+        return false;
+    }
+
+    TelemetryRecord r;
+    const uint8_t* p = raw + 1;
+    r.type = *p++;
+    r.sequence = *p++;
+    r.uptimeMs = get32(p); p += 4;
+    r.temperatureQ = (int16_t)get16(p); p += 2;
+    r.temperatureRaw = get16(p); p += 2;
+    r.rainLevel = get16(p); p += 2;
+    r.waterLevelRaw = get16(p); p += 2;
+    r.waterPercentQ = get16(p); p += 2;
+    r.flags = *p++;
+    r.operationMode = *p++;
+    r.lastUpdate = get32(p); p += 4;
+    r.humidityQ = get16(p); p += 2;
+    r.heatIndexQ = (int16_t)get16(p);
+
+    if (haveSequence) {
+        stats.lostFrames += (uint8_t)(r.sequence - last.sequence - 1);
+    }
+    haveSequence = true;
+    last = r;
+    stats.frames++;
+    return true;
+}
@@ -0,0 +1,110 @@
+/*
+ * SmartCool Parasol - 바이너리 텔레메트리 프레임
+ *
+ * 텍스트 상태 출력(수백 바이트)을 대신하는 고정 길이 프레임.
+ *   페이로드(리틀엔디언) + CRC16-CCITT → COBS 인코딩 → 0x00 구분자
+ * COBS 덕분에 프레임 안에는 0x00이 없으므로, 수신 측은 중간부터 읽어도
+ * 다음 0x00에서 바로 동기를 맞춘다. 9600bps에서 프레임 하나는 약 30ms.
+ *
+ * 펌웨어(인코더)와 호스트(디코더)가 이 파일을 같이 쓴다.
+ * ControlCore에 의존하지 않으므로 호스트 도구는 이 파일만 링크하면 된다.
+ */
+
+#ifndef SMARTCOOL_TELEMETRY_H
+#define SMARTCOOL_TELEMETRY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// 페이로드 배치가 바뀌면 올린다. 디코더는 모르는 버전을 버린다
+// 2: 습도/체감 온도 추가 (더위 판단에 쓰이므로)
+const uint8_t TELEMETRY_VERSION = 2;
+
+enum TelemetryType {
+    TELEMETRY_STATUS = 1,   // 주기 보고
+    TELEMETRY_EVENT = 2     // 모드/펌프 변화 즉시 보고 (내용은 같음)
+};
+
+// flags 비트
+enum TelemetryFlag {
+    TFLAG_SENSORS_VALID    = 0x01,
+    TFLAG_WATER_OK         = 0x02,
+    TFLAG_PARASOL_DEPLOYED = 0x04,
+    TFLAG_PUMP_ACTIVE      = 0x08,
+    TFLAG_SYSTEM_READY     = 0x10,
+    TFLAG_RAIN_DETECTED    = 0x20,
+    TFLAG_HEAT_DETECTED    = 0x40,
+    TFLAG_HUMIDITY_VALID   = 0x80     // 더위 판단이 체감 온도 기준
+};
+
+// SensorData + SystemStatus를 전송용으로 펼친 값 (호스트/펌웨어 공용)
+struct TelemetryRecord {
+    uint8_t type;
+    uint8_t sequence;           // 프레임마다 1씩 증가, 유실 검출용
+    uint32_t uptimeMs;
+    int16_t temperatureQ;       // Q8.8 °C
+    uint16_t temperatureRaw;
+    uint16_t rainLevel;
+    uint16_t waterLevelRaw;
+    uint16_t waterPercentQ;     // Q8.8 %
+    uint8_t flags;
+    uint8_t operationMode;
+    uint32_t lastUpdate;
+    uint16_t humidityQ;         // Q8.8 % (TFLAG_HUMIDITY_VALID일 때만 의미 있음)
+    int16_t heatIndexQ;         // Q8.8 °C 체감 온도
+};
+
+// version(1) + 위 필드(26), 뒤에 CRC(2)
+const uint8_t TELEMETRY_PAYLOAD_SIZE = 27;
+const uint8_t TELEMETRY_RAW_SIZE = TELEMETRY_PAYLOAD_SIZE + 2;
+// COBS 오버헤드 1바이트 + 구분자
+const uint8_t TELEMETRY_FRAME_MAX = TELEMETRY_RAW_SIZE + 2;
+
+// ============= 저수준 =============
+// CRC16-CCITT (다항식 0x1021, 초기값 0xFFFF)
+uint16_t crc16Ccitt(const uint8_t* data, size_t length, uint16_t crc = 0xFFFF);
+
+// 0x00 없는 바이트열로 인코딩. out은 length + length/254 + 1 이상. 인코딩 길이 반환
+size_t cobsEncode(const uint8_t* in, size_t length, uint8_t* out);
+
+// 구분자를 뗀 COBS 블록을 복원. 형식이 틀리면 0
+size_t cobsDecode(const uint8_t* in, size_t length, uint8_t* out);
+
+// ============= 프레임 =============
+// 구분자 0x00까지 포함한 프레임을 out(TELEMETRY_FRAME_MAX)에 쓰고 길이 반환
+uint8_t encodeTelemetryFrame(const TelemetryRecord& record, uint8_t* out);
+
+// 바이트 단위로 밀어 넣는 스트림 디코더 (호스트 도구용)
+class TelemetryDecoder {
+public:
+    struct Counters {
+        unsigned long frames;           // 정상 프레임
+        unsigned long crcErrors;
+        unsigned long framingErrors;    // COBS 오류/길이 불일치/버퍼 초과
+        unsigned long versionErrors;    // 모르는 버전
+        unsigned long lostFrames;       // sequence 건너뜀 합계
+    };
+
+    TelemetryDecoder();
+
+    void reset();
+
+    // 프레임 하나가 완성되면 true, record()로 읽는다
+    bool feed(uint8_t byte);
+
+    // 구분자를 뗀 COBS 블록 하나를 해석 (스트림을 직접 자르는 호스트 도구용)
+    bool decode(const uint8_t* block, size_t blockLength);
+
+    const TelemetryRecord& record() const { return last; }
+    const Counters& counters() const { return stats; }
+
+private:
+    uint8_t buffer[TELEMETRY_FRAME_MAX];
+    uint8_t length;
+    bool overflow;
+    bool haveSequence;
+    TelemetryRecord last;
+    Counters stats;
+};
+
+#endif
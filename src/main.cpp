@@ -1,319 +1,565 @@
 /*
  * SmartCool Parasol - 포텐셔미터 온도 시뮬레이션
  * 0-40도C 범위, 28도C 임계값
+ * 비블로킹 태스크 스케줄러로 센싱/모드판단/구동/보고를 분리 실행
+ *
+ * 제어 로직은 lib/SmartCool/ControlCore 에 있고,
+ * 이 파일은 부팅 순서와 시리얼 출력만 담당한다.
+ * 하드웨어 자가 진단은 부팅을 막지 않고 제어 틱 사이에 진행한다 (SelfTest.h).
+ *
+ * 시리얼 명령 (한 글자)
+ *   b: 바이너리 텔레메트리 (COBS 프레임, 호스트에서 [env:telemetry]로 해석)
+ *   t: 텍스트 상태 출력 (기본)
+ *   p: 단계별 실행 시간/히스토그램/마감 초과 (릴리즈 빌드에서는 없음)
+ *   m: SRAM 사용량 (정적/힙/스택 최대 깊이/조각화)
+ *   j: EEPROM 이벤트 기록 (모드 전환, 펌프 ON/OFF, 오래된 것부터, 시각은 부팅 후 초)
+ *
+ * 보정 명령 (한 줄, 줄바꿈으로 끝)
+ *   c                 보정값 목록 (사용 중 / 편집본 / 범위)
+ *   c <항목> <값>     편집본 변경. 항목: heat heat_hyst rain rain_hyst water water_empty water_full
+ *   c save            편집본 검사 후 한 번에 적용하고 EEPROM에 저장
+ *   c revert          편집본을 사용 중인 값으로
+ *   c defaults        편집본을 기본값으로 (save 해야 적용)
+ *   c auto [stop]     빗물/수위 분위수 수집 시작(처음부터) / 중지 (AutoCalibration.h)
+ *   c propose         수집한 분위수와 제안값 출력, 제안을 편집본에 넣음 (save 해야 적용)
+ *
+ * 이벤트/상태 줄은 Messages.h 카탈로그 메시지(LOGM_*)라 [env:uno_catalog]로
+ * 빌드하면 번호와 인자만 나간다 (호스트에서 [env:telemetry]로 펼침).
+ * 명령에 대한 응답은 LOGM_REPLY라 [env:uno_release](LOG_LEVEL=2)에서도 나간다.
  */
 
 #include <Arduino.h>
-#include <Servo.h>
-
-// 핀 정의
-#define TEMP_POTENTIOMETER_PIN A1
-#define RAIN_SENSOR_PIN A0
-#define WATER_LEVEL_PIN A3
-#define SERVO_PIN 9
-#define RELAY_PIN 6
-
-// 객체 초기화
-Servo parasolServo;
-
-// 전역 변수
-struct SensorData {
-    float temperature;
-    int rainLevel;
-    int waterLevelRaw;
-    float waterLevelPercent;
-    bool waterLevelOK;
-    bool isValid;
-} sensors;
-
-struct SystemStatus {
-    bool parasolDeployed;
-    bool pumpActive;
-    bool systemReady;
-    unsigned long lastUpdate;
-    int operationMode; // 0: 대기, 1: 비모드, 2: 더위모드
-} status;
-
-// 상태 변수 (내부 로직용)
-bool rainDetected = false;  // 현재 비가 오는지
-bool heatDetected = false;  // 현재 더위인지
-
-// 임계값 설정
-const float HEAT_THRESHOLD = 28.0;
-const int RAIN_THRESHOLD = 500
-;
-const int WATER_THRESHOLD = 600;
-
-// 수위 센서 기본 설정값
-const int WATER_EMPTY_VALUE = 100;
-const int WATER_FULL_VALUE = 900;
+#include <Actuators.h>
+#include <AutoCalibration.h>
+#include <Calibration.h>
+#include <ControlCore.h>
+#include <Dht.h>
+#include <Journal.h>
+#include <Log.h>
+#include <MessageLog.h>
+#include <MemoryMonitor.h>
+#include <Profiler.h>
+#include <SelfTest.h>
+#include <Telemetry.h>
 
 // 함수 선언
-void initializeSystem();
-void initializePins();
-void initializeActuators();
-void performHardwareTest();
-int readWaterLevelRaw();
-float calculateWaterPercent(int rawValue);
-void readAllSensors();
-void updateSystemMode();
-void controlParasol();
-void controlWaterPump();
+void pollSelfTest();
+void printModeChange(int mode);
+void printPumpEvent(PumpEvent event);
 void printSystemStatus();
-void relayON();
-void relayOFF();
+void reportStatus();
+void sendTelemetry(uint8_t type);
+void handleSerialCommand();
+void runCalibrationCommand(char* line);
+
+// 여러 줄 보고 한 줄 출력. 더 출력할 줄이 있으면 true
+typedef bool (*ReportLine)(uint8_t line);
+void startReport(ReportLine report);
+void continueReport();
+bool printStatusLine(uint8_t line);
+bool printMemoryLine(uint8_t line);
+bool printJournalLine(uint8_t line);
+bool printCalibrationLine(uint8_t line);
+bool printAutoCalLine(uint8_t line);
+#if PROFILE_ENABLED
+bool printProfileLine(uint8_t line);
+#endif
+
+const ControlHooks hooks = {
+    printModeChange,
+    printPumpEvent,
+    reportStatus
+};
+
+// 상태 보고 형식. 바이너리일 때는 텍스트를 섞지 않는다 (프레임 동기 유지)
+bool binaryTelemetry = false;
+uint8_t telemetrySequence = 0;
+ReportLine pendingReport = 0;   // 출력 중인 여러 줄 보고
+ReportLine queuedReport = 0;
+uint8_t reportLine = 0;
+
+// 'c'로 시작한 보정 명령 줄 (줄바꿈까지 모은다. 그동안 한 글자 명령은 쉰다)
+const uint8_t COMMAND_LINE_MAX = 24;
+char commandLine[COMMAND_LINE_MAX];
+uint8_t commandLength = 0;
+bool readingCommandLine = false;
 
 void setup() {
-    Serial.begin(9600);
-    Serial.println(F("=== SmartCool Parasol ==="));
-    Serial.println(F("포텐셔미터 온도: 0-40도C (임계: 28도C)"));
-    Serial.println();
-
+    // 리셋 직후 먼저 안전 상태 (파라솔 수납, 펌프 OFF)로 두고 바로 제어를 시작한다.
+    // 블로킹 출력은 9600bps에서 줄마다 수십 ms라 부팅 메시지도 TX 링에만 넣는다
     initializeSystem();
     initializePins();
     initializeActuators();
-    performHardwareTest();
+    selfTest.begin();
+    controlBegin(hooks);
 
-    Serial.println(F("시스템 준비 완료!"));
-    Serial.println(F("=========================================="));
+    Serial.begin(9600);
+    LOG_INFO(F("=== SmartCool Parasol ==="));
+    LOG_INFO(F("포텐셔미터 온도: 0-40도C (임계: 28도C)"));
+    if (selfTest.cached()) {
+        LOGM_INFO(MSG_SELFTEST_CACHED, status.systemReady, selfTest.record().runs, selfTest.record().sweepMs);
+    } else {
+        LOGM_INFO(MSG_SELFTEST_NO_CACHE);
+    }
+    LOG_INFO(F("=========================================="));
 }
 
 void loop() {
-    // 상태 출력 (10초마다)
-    if (millis() - status.lastUpdate > 10000) {
-        readAllSensors();
-        updateSystemMode();
-        controlParasol();
-        controlWaterPump();
-        printSystemStatus();
-        status.lastUpdate = millis();
-    }
-    delay(500);
+    handleSerialCommand();
+    controlTick();
+    pollSelfTest();
+    continueReport();
 }
 
-void initializeSystem() {
-    Serial.println(F("시스템 초기화..."));
+// 진단 단계가 끝날 때만 한 줄씩 알린다. 바이너리 모드에서는 systemReady 플래그로 충분
+void pollSelfTest() {
+    SelfTestEvent event = selfTest.poll();
+    if (event == SELFTEST_EVENT_NONE || binaryTelemetry) return;
 
-    status.parasolDeployed = false;
-    status.pumpActive = false;
-    status.systemReady = false;
-    status.lastUpdate = millis();
-    status.operationMode = 0;
-
-    sensors.temperature = 0.0;
-    sensors.rainLevel = 0;
-    sensors.waterLevelRaw = 0;
-    sensors.waterLevelPercent = 0.0;
-    sensors.waterLevelOK = false;
-    sensors.isValid = false;
+    switch (event) {
+    case SELFTEST_EVENT_SENSORS:
+        // 배선 확인용. 필터를 거친 값이라 부팅 직후 한 번 읽는 것보다 안정적이다
+        LOGM_INFO(MSG_HWTEST_TEMP, tenths(sensors.temperature.tenths()), heatDetected);
+        LOGM_INFO(MSG_HWTEST_WATER, sensors.waterLevelRaw, sensors.waterLevelOK);
+        break;
+    case SELFTEST_EVENT_COMPLETE:
+        LOGM_INFO(MSG_SELFTEST_DONE, (selfTest.result() & SELFTEST_SENSORS) != 0,
+                  (selfTest.result() & SELFTEST_SERVO) != 0, selfTest.record().sweepMs,
+                  (selfTest.result() & SELFTEST_RELAY) != 0);
+        break;
+    case SELFTEST_EVENT_ABORTED:
+        LOGM_INFO(MSG_SELFTEST_ABORTED);
+        break;
+    default:
+        break;
+    }
+}
 
-    rainDetected = false;
-    heatDetected = false;
+void handleSerialCommand() {
+    if (Serial.available() <= 0) return;
+    char c = (char)Serial.read();
+
+    if (readingCommandLine) {
+        if (c == '\n' || c == '\r') {
+            commandLine[commandLength] = 0;
+            readingCommandLine = false;
+            runCalibrationCommand(commandLine);
+        } else if (commandLength < COMMAND_LINE_MAX - 1) {
+            commandLine[commandLength++] = c;
+        }
+        return;
+    }
 
-    Serial.println(F("초기화 완료"));
+    switch (c) {
+    case 'b':
+        // 앞서 나간 텍스트와는 logWriteFrame이 구분자로 끊어 준다
+        binaryTelemetry = true;
+        sendTelemetry(TELEMETRY_STATUS);
+        break;
+    case 't':
+        binaryTelemetry = false;
+        LOG_INFO();
+        LOG_INFO(F("텍스트 출력 모드"));
+        break;
+    case 'm':
+        startReport(printMemoryLine);
+        break;
+    case 'j':
+        startReport(printJournalLine);
+        break;
+    case 'c':
+        readingCommandLine = true;
+        commandLength = 0;
+        break;
+#if PROFILE_ENABLED
+    case 'p':
+        startReport(printProfileLine);
+        break;
+#endif
+    }
 }
 
-void initializePins() {
-    pinMode(RELAY_PIN, OUTPUT);
-    relayOFF();
+void printModeChange(int mode) {
+    if (binaryTelemetry) {
+        sendTelemetry(TELEMETRY_EVENT);
+        return;
+    }
+    LOGM_INFO(MSG_MODE_CHANGED, mode);
 }
 
-void initializeActuators() {
-    parasolServo.attach(SERVO_PIN);
-    parasolServo.write(30);
-    relayOFF();
+void printPumpEvent(PumpEvent event) {
+    if (binaryTelemetry) {
+        sendTelemetry(TELEMETRY_EVENT);
+        return;
+    }
+    switch (event) {
+    case PUMP_STARTED: LOGM_INFO(MSG_PUMP_STARTED); break;
+    case PUMP_STOPPED_LOW_WATER: LOGM_WARN(MSG_PUMP_LOW_WATER); break;
+    default: break;
+    }
 }
 
-void relayOFF() {
-    digitalWrite(RELAY_PIN, LOW);
-    status.pumpActive = false;
+void reportStatus() {
+    if (binaryTelemetry) {
+        sendTelemetry(TELEMETRY_STATUS);
+    } else {
+        printSystemStatus();
+    }
 }
 
-void relayON() {
-    digitalWrite(RELAY_PIN, HIGH);
-    status.pumpActive = true;
+// 프레임 하나 (TELEMETRY_FRAME_MAX 바이트 이하, 9600bps에서 약 30ms. 텍스트 보고는 수백 바이트)
+void sendTelemetry(uint8_t type) {
+    TelemetryRecord record;
+    fillTelemetry(record);
+    record.type = type;
+    record.sequence = telemetrySequence++;
+
+    uint8_t frame[TELEMETRY_FRAME_MAX];
+    uint8_t length = encodeTelemetryFrame(record, frame);
+    logWriteFrame(frame, length);
 }
 
-int readWaterLevelRaw() {
-    long sum = 0;
-    for (int i = 0; i < 5; i++) {
-        sum += analogRead(WATER_LEVEL_PIN);
-        delay(10);
+// 여러 줄 보고는 한 번에 넣으면 TX 링(255바이트)을 넘친다.
+// 한 줄씩, 링에 한 줄이 들어갈 자리가 날 때마다 loop()에서 이어서 출력한다
+void startReport(ReportLine report) {
+    if (pendingReport) {
+        queuedReport = report;  // 출력 중인 보고가 끝나면 시작
+        return;
     }
-    return sum / 5;
+    pendingReport = report;
+    reportLine = 0;
 }
 
-float calculateWaterPercent(int rawValue) {
-    if (rawValue <= WATER_EMPTY_VALUE) {
-        return 0.0;
-    } else if (rawValue >= WATER_FULL_VALUE) {
-        return 100.0;
-    } else {
-        float range = WATER_FULL_VALUE - WATER_EMPTY_VALUE;
-        float position = rawValue - WATER_EMPTY_VALUE;
-        return (position / range) * 100.0;
+void continueReport() {
+    if (!pendingReport) {
+        if (!queuedReport) return;
+        pendingReport = queuedReport;
+        queuedReport = 0;
+        reportLine = 0;
     }
+    if (binaryTelemetry) {
+        pendingReport = 0;
+        return;
+    }
+    if (hal::serialWritable() < LOG_LINE_MAX) return;
+
+    PROFILE_SCOPE(STAGE_REPORT);
+    if (!pendingReport(reportLine++)) pendingReport = 0;
 }
 
-void performHardwareTest() {
-    Serial.println(F("===== 하드웨어 테스트 ====="));
-
-    // 포텐셔미터 테스트
-    int tempRaw = analogRead(TEMP_POTENTIOMETER_PIN);
-    float tempC = (tempRaw / 1023.0) * 40.0;
-    Serial.print(F("온도: "));
-    Serial.print(tempC, 1);
-    Serial.print(F("°C"));
-    Serial.println(tempC > 28.0 ? F(" [더위!]") : F(" [정상]"));
-
-    // 수위 테스트
-    int waterRaw = readWaterLevelRaw();
-    Serial.print(F("수위: "));
-    Serial.print(waterRaw);
-    Serial.println(waterRaw >= WATER_THRESHOLD ? F(" [충분]") : F(" [부족]"));
-
-    // 서보 테스트
-    Serial.println(F("서보 테스트..."));
-    parasolServo.write(30);
-    delay(1000);
-    parasolServo.write(80);
-    delay(1000);
-    parasolServo.write(130);
-    delay(1000);
-    parasolServo.write(80);
-    delay(1000);
-    parasolServo.write(30);
-    delay(1000);
-
-    // 릴레이 테스트
-    Serial.println(F("릴레이 테스트..."));
-    relayON();
-    delay(500);
-    relayOFF();
-
-    status.systemReady = true;
-    Serial.println(F("============================"));
+void printSystemStatus() {
+    startReport(printStatusLine);
 }
 
-void readAllSensors() {
-    // 포텐셔미터로 온도 시뮬레이션
-    long sum = 0;
-    for (int i = 0; i < 5; i++) {
-        sum += analogRead(TEMP_POTENTIOMETER_PIN);
-        delay(500);
+bool printStatusLine(uint8_t line) {
+    switch (line) {
+    case 0:
+        LOGM_INFO(MSG_STATUS_HEADER);
+        return true;
+    case 1:
+        LOGM_INFO(MSG_STATUS_TEMP_RAIN, tenths(sensors.temperature.tenths()), heatDetected,
+                  sensors.rainLevel, rainDetected);
+        return true;
+    case 2:
+        LOGM_INFO(MSG_STATUS_WATER, tenths(sensors.waterLevelPercent.tenths()),
+                  sensors.waterLevelOK);
+        return true;
+    case 3:
+        if (parasolMotion.moving()) {
+            LOGM_INFO(MSG_STATUS_PARASOL_MOVE, status.parasolDeployed,
+                      parasolMotion.progress(), parasolMotion.msToArrival());
+        } else {
+            LOGM_INFO(MSG_STATUS_PARASOL, status.parasolDeployed);
+        }
+        return true;
+    case 4:
+        LOGM_INFO(MSG_STATUS_PUMP_MODE, status.pumpActive, status.operationMode);
+        return true;
+    case 5:
+        LOGM_INFO(MSG_STATUS_COMMANDS,
+                  actuators.stats(ACT_RELAY).applied, actuators.stats(ACT_RELAY).suppressed,
+                  actuators.stats(ACT_PARASOL).applied, actuators.stats(ACT_PARASOL).suppressed);
+        return true;
+    case 6: {
+        const LogStats& log = logStats();
+        LOGM_INFO(MSG_STATUS_LOG, log.written, log.dropped, log.droppedBytes, log.truncated);
+        return true;
+    }
+    case 7: {
+        MemoryReport mem;
+        memorySnapshot(mem);
+        LOGM_INFO(MSG_STATUS_SRAM, mem.freeBytes, mem.unusedMinBytes, mem.stackPeakBytes);
+        return true;
+    }
+    case 8:
+        LOGM_INFO(MSG_STATUS_RAIN_ONSET, rainOnsetStats.trips, rainOnsetStats.preemptions,
+                  rainOnsetStats.lastMicros, rainOnsetStats.maxMicros);
+        return true;
+    case 9:
+        LOGM_INFO(MSG_STATUS_HUMIDITY, tenths(sensors.humidity.tenths()), sensors.humidityValid,
+                  tenths(sensors.heatIndex.tenths()));
+        return true;
+    case 10:
+        LOGM_INFO(MSG_STATUS_DHT, dht.stats().reads, dht.stats().checksumErrors, dht.stats().timeouts);
+        return true;
+    default:
+        LOGM_INFO(MSG_REPORT_FOOTER);
+        return false;
     }
-    int raw = sum / 5;
-    sensors.temperature = (raw / 1023.0) * 40.0;
-    
-    // 빗물 센서
-    sensors.rainLevel = analogRead(RAIN_SENSOR_PIN);
-    
-    // 수위 센서
-    sensors.waterLevelRaw = readWaterLevelRaw();
-    sensors.waterLevelPercent = calculateWaterPercent(sensors.waterLevelRaw);
-    sensors.waterLevelOK = (sensors.waterLevelRaw >= WATER_THRESHOLD);
-    
-    sensors.isValid = true;
 }
 
-void updateSystemMode() {
-    if (!status.systemReady) return;
+// 스택/힙 충돌 위험 확인용. 최소 여유가 0에 가까우면 스택이 힙(또는 전역)을 덮은 적이 있다
+bool printMemoryLine(uint8_t line) {
+    MemoryReport mem;
+    memorySnapshot(mem);
+
+    switch (line) {
+    case 0:
+        LOGM_REPLY(MSG_MEM_HEADER, mem.totalBytes);
+        return true;
+    case 1:
+        LOGM_REPLY(MSG_MEM_STATIC, mem.dataBytes, mem.bssBytes, mem.dataBytes + mem.bssBytes);
+        return true;
+    case 2:
+        LOGM_REPLY(MSG_MEM_HEAP, mem.heapBytes, mem.heapFreeBytes, mem.heapLargestFree,
+                  heapFragmentationPercent(mem));
+        return true;
+    case 3:
+        LOGM_REPLY(MSG_MEM_STACK, mem.stackBytes, mem.stackPeakBytes);
+        return true;
+    case 4:
+        LOGM_REPLY(MSG_MEM_FREE, mem.freeBytes, mem.unusedMinBytes);
+        return true;
+    default:
+        LOGM_REPLY(MSG_REPORT_FOOTER);
+        return false;
+    }
+}
 
-    // 비와 더위 감지 상태 업데이트
-    rainDetected = (sensors.rainLevel < RAIN_THRESHOLD);
-    heatDetected = (sensors.temperature > HEAT_THRESHOLD);
+// 공백으로 나눈 다음 낱말. 없으면 0
+static char* nextWord(char*& cursor) {
+    while (*cursor == ' ') cursor++;
+    if (*cursor == 0) return 0;
+    char* word = cursor;
+    while (*cursor != 0 && *cursor != ' ') cursor++;
+    if (*cursor != 0) *cursor++ = 0;
+    return word;
+}
 
-    int newMode = status.operationMode;
+static bool parseInt(const char* text, int16_t& value) {
+    bool negative = (*text == '-');
+    if (negative) text++;
+    if (*text == 0) return false;
+    int32_t v = 0;
+    for (; *text; text++) {
+        if (*text < '0' || *text > '9' || v > 9999) return false;
+        v = v * 10 + (*text - '0');
+    }
+    value = (int16_t)(negative ? -v : v);
+    return true;
+}
 
-    // 모드 결정 로직
-    if (rainDetected && heatDetected) {
-        newMode = 1; // 비모드 우선
-    } else if (rainDetected && !heatDetected) {
-        newMode = 1; // 비모드
-    } else if (!rainDetected && heatDetected) {
-        newMode = 2; // 더위모드
-    } else {
-        newMode = 0; // 대기모드
+// c propose 결과. 보고는 한 줄씩 나가므로 명령 시점 값을 들고 있는다
+static AutoCalProposal autoCalProposal;
+static uint8_t autoCalLoaded;
+
+void runCalibrationCommand(char* line) {
+    char* cursor = line;
+    char* word = nextWord(cursor);
+    if (!word) {
+        startReport(printCalibrationLine);
+        return;
     }
 
-    // 모드 변경 시 메시지 출력
-    if (newMode != status.operationMode) {
-        status.operationMode = newMode;
-        switch (newMode) {
-        case 0: Serial.println(F("대기 모드")); break;
-        case 1: Serial.println(F("비 모드")); break;
-        case 2: Serial.println(F("더위 모드")); break;
+    CalibrationResult result = CAL_OK;
+    uint8_t key;
+    int16_t value;
+    if (strcmp_P(word, PSTR("save")) == 0) {
+        result = calibration.commit();
+        if (result == CAL_OK) LOGM_REPLY(MSG_CAL_APPLIED, calibration.sequence());
+    } else if (strcmp_P(word, PSTR("revert")) == 0) {
+        calibration.revert();
+        LOGM_REPLY(MSG_CAL_EDIT, 0);
+    } else if (strcmp_P(word, PSTR("defaults")) == 0) {
+        calibration.loadDefaults();
+        LOGM_REPLY(MSG_CAL_EDIT, 1);
+    } else if (strcmp_P(word, PSTR("auto")) == 0) {
+        char* option = nextWord(cursor);
+        bool stop = option && strcmp_P(option, PSTR("stop")) == 0;
+        if (option && !stop) {
+            LOGM_REPLY(MSG_CAL_USAGE);
+            return;
         }
+        if (stop) autoCalibration.stop();
+        else autoCalibration.start();
+        LOGM_REPLY(MSG_AUTOCAL_STATE, !stop, autoCalibration.quantiles(AUTOCAL_RAIN).samples(),
+                  AUTOCAL_SAMPLE_MS / 1000);
+    } else if (strcmp_P(word, PSTR("propose")) == 0) {
+        autoCalibration.propose(calibration, autoCalProposal);
+        autoCalLoaded = AutoCalibration::loadProposal(autoCalProposal, calibration);
+        startReport(printAutoCalLine);
+    } else if (calibrationKeyFromName(word, key)) {
+        char* number = nextWord(cursor);
+        if (!number || !parseInt(number, value)) {
+            LOGM_REPLY(MSG_CAL_USAGE);
+            return;
+        }
+        result = calibration.set(key, value);
+        if (result == CAL_OK) LOGM_REPLY(MSG_CAL_SET, key, value);
+    } else {
+        result = CAL_UNKNOWN_KEY;
     }
+    if (result != CAL_OK) LOGM_REPLY(MSG_CAL_ERROR, result);
+}
 
-    delay(3000);
+// 머리 한 줄, 항목마다 한 줄
+bool printCalibrationLine(uint8_t line) {
+    if (line == 0) {
+        LOGM_REPLY(MSG_CAL_HEADER, calibration.stored(), calibration.sequence());
+        return true;
+    }
+    uint8_t key = line - 1;
+    if (key < CAL_KEY_COUNT) {
+        LOGM_REPLY(MSG_CAL_VALUE, key, calibration.value(key), calibration.edited(key),
+                  calibrationMin(key), calibrationMax(key));
+        return true;
+    }
+    LOGM_REPLY(MSG_REPORT_FOOTER);
+    return false;
 }
 
-void controlParasol() {
-    switch (status.operationMode) {
-    case 0: // 대기 모드 - 수납
-        if (status.parasolDeployed) {
-            parasolServo.write(30);
-            delay(1000);
-            status.parasolDeployed = false;
+// 머리, 채널 2줄, 채널별 제안 2줄, 편집본에 넣은 개수 (c propose가 채운 값)
+bool printAutoCalLine(uint8_t line) {
+    switch (line) {
+    case 0:
+        LOGM_REPLY(MSG_AUTOCAL_HEADER, autoCalibration.running(),
+                  autoCalibration.quantiles(AUTOCAL_RAIN).samples());
+        return true;
+    case 1:
+    case 2: {
+        uint8_t channel = line - 1;
+        const AutoCalQuantiles& q = autoCalibration.quantiles(channel);
+        LOGM_REPLY(MSG_AUTOCAL_CHANNEL, channel, q.minimum(), q.low(), q.high(), q.maximum());
+        return true;
+    }
+    case 3:
+        if (autoCalProposal.rainResult == AUTOCAL_OK) {
+            LOGM_REPLY(MSG_AUTOCAL_RAIN, autoCalProposal.rain,
+                      autoCalibration.quantiles(AUTOCAL_RAIN).low(),
+                      autoCalibration.quantiles(AUTOCAL_RAIN).high());
+        } else {
+            LOGM_REPLY(MSG_AUTOCAL_SKIP, AUTOCAL_RAIN, autoCalProposal.rainResult);
         }
-        break;
+        return true;
+    case 4:
+        if (autoCalProposal.waterResult == AUTOCAL_OK) {
+            LOGM_REPLY(MSG_AUTOCAL_WATER, autoCalProposal.waterEmpty, autoCalProposal.waterFull,
+                      autoCalProposal.water);
+        } else {
+            LOGM_REPLY(MSG_AUTOCAL_SKIP, AUTOCAL_WATER, autoCalProposal.waterResult);
+        }
+        return true;
+    case 5:
+        if (autoCalLoaded) LOGM_REPLY(MSG_AUTOCAL_LOADED, autoCalLoaded);
+        return true;
+    default:
+        LOGM_REPLY(MSG_REPORT_FOOTER);
+        return false;
+    }
+}
 
-    case 1: // 비 모드 - 빗물 수집 각도
-        parasolServo.write(130);
-        delay(1000);
-        status.parasolDeployed = true;
-        break;
+// 한 줄에 기록 하나 (슬롯 192 + 대기열 8이라 uint8_t 줄 번호 안에 든다).
+// 출력 중 새 기록이 슬롯을 한 바퀴 넘기면 그만큼 한 건씩 밀려 보인다
+static_assert(JOURNAL_SLOTS + JOURNAL_PENDING < 255, "journal dump line index overflows uint8_t");
+static unsigned long journalSeconds;
+static unsigned long journalPumpOnAt;
+static bool journalPumpOnKnown;
+
+bool printJournalLine(uint8_t line) {
+    if (line == 0) {
+        const JournalStats& st = journal.stats();
+        LOGM_REPLY(MSG_JOURNAL_HEADER, journal.size(), journal.storedCount(), JOURNAL_SLOTS,
+                  journal.pending(), st.dropped);
+        journalSeconds = 0;
+        journalPumpOnKnown = false;
+        return true;
+    }
 
-    case 2: // 더위 모드 - 차양 각도
-        parasolServo.write(80);
-        delay(1000);
-        status.parasolDeployed = true;
+    uint16_t index = line - 1;
+    JournalEntry e;
+    if (!journal.entry(index, e)) {
+        LOGM_REPLY(MSG_REPORT_FOOTER);
+        return false;
+    }
+    if (!e.intact) {
+        LOGM_REPLY(MSG_JOURNAL_DAMAGED, index);
+        return true;
+    }
+
+    // 시간 차를 부팅 기록부터 더해 부팅 후 초로
+    journalSeconds = e.type == JOURNAL_BOOT ? 0 : journalSeconds + e.deltaSeconds;
+    switch (e.type) {
+    case JOURNAL_BOOT:
+        journalPumpOnKnown = false;
+        LOGM_REPLY(MSG_JOURNAL_BOOT, index);
+        break;
+    case JOURNAL_MODE:
+        LOGM_REPLY(MSG_JOURNAL_MODE, index, journalSeconds, e.arg);
+        break;
+    case JOURNAL_PUMP_ON:
+        journalPumpOnAt = journalSeconds;
+        journalPumpOnKnown = true;
+        LOGM_REPLY(MSG_JOURNAL_PUMP_ON, index, journalSeconds);
+        break;
+    case JOURNAL_PUMP_OFF:
+        if (journalPumpOnKnown) {
+            LOGM_REPLY(MSG_JOURNAL_PUMP_RUN, index, journalSeconds, e.arg,
+                      journalSeconds - journalPumpOnAt);
+        } else {
+            LOGM_REPLY(MSG_JOURNAL_PUMP_OFF, index, journalSeconds, e.arg);
+        }
+        journalPumpOnKnown = false;
+        break;
+    default:
+        LOGM_REPLY(MSG_JOURNAL_DAMAGED, index);
         break;
     }
+    return true;
 }
 
-void controlWaterPump() {
-    bool shouldPumpRun = (status.operationMode == 2) && sensors.waterLevelOK;
+#if PROFILE_ENABLED
+// 단계마다 통계 한 줄 + 히스토그램 한 줄, 마지막에 태스크 마감 초과
+bool printProfileLine(uint8_t line) {
+    if (line == 0) {
+        LOGM_INFO(MSG_PROF_HEADER);
+        return true;
+    }
+    if (line == 1) {
+        LOGM_INFO(MSG_PROF_BUCKETS);
+        return true;
+    }
 
-    if (shouldPumpRun && !status.pumpActive) {
-        relayON();
-        Serial.println(F("미스트 분사 시작"));
-    } else if (!shouldPumpRun && status.pumpActive) {
-        relayOFF();
-        if (status.operationMode == 2 && !sensors.waterLevelOK) {
-            Serial.println(F("수위 부족 - 펌프 정지"));
+    uint8_t stage = (line - 2) >> 1;
+    if (stage < STAGE_COUNT) {
+        const StageStats& st = profileStage(stage);
+        if ((line & 1) == 0) {
+            LOGM_INFO(MSG_PROF_STAGE, stage, st.count, profileMeanUs(stage), st.minUs, st.maxUs);
+        } else {
+            const uint8_t* b = st.buckets;
+            LOGM_INFO(MSG_PROF_HISTOGRAM, b[0], b[1], b[2], b[3], b[4],
+                      b[5], b[6], b[7], b[8], b[9]);
         }
+        return true;
     }
-}
 
-void printSystemStatus() {
-    Serial.println(F("===== 시스템 상태 ====="));
-
-    Serial.print(F("온도: "));
-    Serial.print(sensors.temperature, 1);
-    Serial.print(F("°C "));
-    
-    Serial.print(F("비: "));
-    Serial.print(sensors.rainLevel, 1);
-    Serial.print(F("%"));
-    Serial.print(heatDetected ? F("[더위감지]") : F("[정상]"));
-    Serial.print(F(" | 비: "));
-    Serial.print(rainDetected ? F("[감지]") : F("[없음]"));
-    Serial.print(F(" | 수위: "));
-    Serial.print(sensors.waterLevelPercent, 1);
-    Serial.println(sensors.waterLevelOK ? F("% [충분]") : F("% [부족]"));
-
-    Serial.print(F("파라솔: "));
-    Serial.print(status.parasolDeployed ? F("전개") : F("수납"));
-    Serial.print(F(" | 펌프: "));
-    Serial.print(status.pumpActive ? F("ON") : F("OFF"));
-    Serial.print(F(" | 모드: "));
-    switch (status.operationMode) {
-    case 0: Serial.println(F("대기")); break;
-    case 1: Serial.println(F("비")); break;
-    case 2: Serial.println(F("더위")); break;
+    if (stage == STAGE_COUNT && (line & 1) == 0) {
+        LOGM_INFO(MSG_PROF_OVERRUNS, profileLoopOverruns(),
+                  scheduler.task(TASK_SENSE).overruns, scheduler.task(TASK_MODE).overruns,
+                  scheduler.task(TASK_ACTUATE).overruns, scheduler.task(TASK_MOTION).overruns,
+                  scheduler.task(TASK_REPORT).overruns);
+        return true;
     }
-
-    Serial.println(F("=========================="));
+    LOGM_INFO(MSG_REPORT_FOOTER);
+    return false;
 }
+#endif
@@ -0,0 +1,1230 @@
+/*
+ * SmartCool Parasol - 네이티브(호스트) 회귀/성능 테스트
+ *
+ * 실행: pio run -e native && .pio/build/native/program
+ *
+ * 가상 핀과 가상 시계 위에서 ControlCore를 그대로 돌린다.
+ * 1) 시나리오별로 모드/서보/릴레이 결과를 확인하고 (실패 시 종료코드 1)
+ * 2) 제어 루프를 수백만 번 돌려 초당 반복 횟수를 출력한다.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include <cmath>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <Actuators.h>
+#include <AdcSampler.h>
+#include <AutoCalibration.h>
+#include <Calibration.h>
+#include <ControlCore.h>
+#include <Dht.h>
+#include <EepromLayout.h>
+#include <HalNative.h>
+#include <Journal.h>
+#include <Filters.h>
+#include <Format.h>
+#include <Log.h>
+#include <MessageLog.h>
+#include <Profiler.h>
+#include <SelfTest.h>
+#include <SensorRegistry.h>
+#include <ServoPwm.h>
+#include <Telemetry.h>
+
+namespace {
+
+int failures = 0;
+int modeChanges = 0;
+int lowWaterStops = 0;
+
+void onModeChanged(int) { modeChanges++; }
+void onPumpEvent(PumpEvent event) {
+    if (event == PUMP_STOPPED_LOW_WATER) lowWaterStops++;
+}
+
+const ControlHooks hooks = { onModeChanged, onPumpEvent, 0 };
+
+void check(bool condition, const char* what) {
+    printf("  [%s] %s\n", condition ? " OK " : "FAIL", what);
+    if (!condition) failures++;
+}
+
+void setInputs(uint16_t tempRaw, uint16_t rainRaw, uint16_t waterRaw) {
+    hal::native::setAnalog(TEMPERATURE_PIN, tempRaw);
+    hal::native::setAnalog(RAIN_SENSOR_PIN, rainRaw);
+    hal::native::setAnalog(WATER_LEVEL_PIN, waterRaw);
+}
+
+// 1ms 단위로 가상 시계를 진행하며 제어 루프 실행
+void runFor(unsigned long ms) {
+    for (unsigned long i = 0; i < ms; i++) {
+        hal::native::advance(1);
+        controlTick();
+    }
+}
+
+// 조건이 만족될 때까지 걸린 시간(ms), 제한 초과 시 limit + 1
+template <typename Predicate>
+unsigned long runUntil(Predicate done, unsigned long limit) {
+    for (unsigned long ms = 0; ms <= limit; ms++) {
+        if (done()) return ms;
+        hal::native::advance(1);
+        controlTick();
+    }
+    return limit + 1;
+}
+
+void boot() {
+    hal::native::reset();
+    initializeSystem();
+    initializePins();
+    initializeActuators();
+    status.systemReady = true;  // 네이티브에서는 하드웨어 테스트 생략
+    controlBegin(hooks);
+    modeChanges = 0;
+    lowWaterStops = 0;
+}
+
+void scenarios() {
+    printf("===== 시나리오 =====\n");
+    boot();
+
+    // 맑고 선선함 → 대기 (더위 진입 최소 유지 시간만큼 대기 모드 유지)
+    setInputs(400, 900, 700);
+    runFor(DWELL_HEAT_ENTER * 1000UL + 1000);
+    check(status.operationMode == MODE_STANDBY, "맑음/선선 → 대기 모드");
+    check(hal::native::servoAngle() == ANGLE_STOWED, "파라솔 수납 각도");
+    check(hal::native::pinLevel(RELAY_PIN) == LOW, "펌프 OFF");
+
+    // 더위 + 수위 충분 → 차양 + 미스트
+    setInputs(800, 900, 700);
+    unsigned long heatLatency = runUntil([] { return hal::native::pinLevel(RELAY_PIN) == HIGH; }, 1000);
+    printf("  더위 감지 → 펌프 ON: %lu ms\n", heatLatency);
+    check(status.operationMode == MODE_HEAT, "더위 → 더위 모드");
+    check(parasolMotion.target() == ANGLE_SHADE, "차양 각도 명령");
+
+    // 차양 각도로 가는 도중 비 시작 → 즉시 빗물 수집 각도로 선점, 펌프 정지
+    runFor(300);
+    check(parasolMotion.moving(), "차양 각도로 램프 이동 중");
+    uint8_t before = hal::native::servoAngle();
+    setInputs(800, 300, 700);
+    unsigned long rainLatency = runUntil([] { return parasolMotion.target() == ANGLE_COLLECT; }, 1000);
+    printf("  비 감지 → 서보 명령: %lu ms (이동 중 %u도에서 선점)\n", rainLatency, before);
+    check(rainLatency <= 5, "비 감지 후 5ms 이내 빗물 수집 각도 명령");
+    check(hal::native::pinLevel(RELAY_PIN) == LOW, "비 모드에서 펌프 OFF");
+    unsigned long collectArrival = runUntil([] { return hal::native::servoAngle() == ANGLE_COLLECT; }, 5000);
+    printf("  빗물 수집 각도 도착: %lu ms 추가\n", collectArrival);
+    check(collectArrival < 5000, "램프 이동 후 빗물 수집 각도 도착");
+
+    // 비가 그쳐도 최소 유지 시간 동안은 빗물 수집 유지
+    setInputs(800, 900, 700);
+    runFor(DWELL_RAIN_EXIT * 1000UL / 2);
+    check(status.operationMode == MODE_RAIN, "비 그친 직후에는 비 모드 유지");
+    runFor(DWELL_RAIN_EXIT * 1000UL / 2 + 1000);
+    check(status.operationMode == MODE_HEAT, "유지 시간 후 더위 모드 복귀");
+
+    // 경계 부근 값은 모드를 흔들지 않음 (히스테리시스)
+    int changes = modeChanges;
+    for (int i = 0; i < 20; i++) {
+        setInputs(i & 1 ? HEAT_THRESHOLD_RAW - 5 : HEAT_THRESHOLD_RAW + 5, i & 1 ? 520 : 540, 700);
+        runFor(2000);
+    }
+    check(modeChanges == changes && status.operationMode == MODE_HEAT, "더위/비 경계 부근에서 모드 전환 없음");
+
+    // 수위 부족 → 더위 모드지만 펌프는 정지
+    setInputs(800, 900, 400);
+    runFor(1000);
+    check(hal::native::pinLevel(RELAY_PIN) == LOW, "수위 부족이면 펌프 OFF");
+    check(lowWaterStops == 1, "수위 부족 정지 이벤트 1회");
+
+    // 더위 모드에 충분히 머문 뒤 조건 해제 → 바로 대기 모드
+    setInputs(400, 900, 700);
+    runFor(1000);
+    check(status.operationMode == MODE_STANDBY, "더위 해제 → 대기 모드");
+
+    // 대기 모드로 막 돌아온 직후의 더위는 최소 유지 시간 뒤에 반영
+    setInputs(800, 900, 700);
+    runFor(DWELL_HEAT_ENTER * 1000UL / 2);
+    check(status.operationMode == MODE_STANDBY, "대기 복귀 직후 더위 재진입 보류");
+    runFor(DWELL_HEAT_ENTER * 1000UL / 2 + 1000);
+    check(status.operationMode == MODE_HEAT, "유지 시간 후 더위 모드 재진입");
+
+    // 더위 모드 진입 직후 조건 해제 → 더위 해제 유지 시간 후 수납
+    setInputs(400, 900, 700);
+    runFor(DWELL_HEAT_EXIT * 1000UL / 2);
+    check(status.operationMode == MODE_HEAT, "더위 진입 직후에는 더위 모드 유지");
+    runFor(DWELL_HEAT_EXIT * 1000UL / 2 + 1000);
+    check(status.operationMode == MODE_STANDBY && !status.parasolDeployed, "대기 모드 복귀 후 수납");
+    check(scheduler.task(TASK_SENSE).overruns == 0, "센싱 태스크 마감 초과 없음");
+
+    // 정상 상태에서는 매 주기 명령이 반복돼도 액추에이터는 건드리지 않음 (DHT 시작 신호는 제외)
+    runFor(3000);   // 수납 램프가 끝날 때까지
+    unsigned long writes = hal::native::servoWrites() + hal::native::digitalWrites(RELAY_PIN);
+    unsigned long suppressed = actuators.stats(ACT_PARASOL).suppressed;
+    runFor(5000);
+    check(hal::native::servoWrites() + hal::native::digitalWrites(RELAY_PIN) == writes,
+          "정상 상태 5초 동안 서보/릴레이 쓰기 없음");
+    check(actuators.stats(ACT_PARASOL).suppressed > suppressed, "반복 명령은 캐시에서 생략");
+
+    // 멈춘 파라솔은 서보 펄스를 끊고, 다음 이동에서 다시 붙인다
+    check(!hal::native::servoAttached() && hal::native::servoDetaches() > 0, "정지 중에는 서보 출력 끊음");
+    unsigned long detaches = hal::native::servoDetaches();
+    setInputs(400, 300, 700);
+    runFor(100);
+    check(hal::native::servoAttached(), "비 시작 시 서보 출력 다시 연결");
+    runFor(500);
+    check(hal::native::servoAttached() && hal::native::servoAngle() < ANGLE_COLLECT, "이동 중에는 출력 유지");
+    runFor(2000 + SERVO_IDLE_DETACH_MS);
+    check(hal::native::servoAngle() == ANGLE_COLLECT && !hal::native::servoAttached() &&
+          hal::native::servoDetaches() == detaches + 1, "도착 후 유지 시간이 지나면 다시 끊음");
+}
+
+// 보드 프로필 핀 → 포트/비트 (SBI/CBI 대상), 네이티브에서는 가상 핀으로
+void board() {
+    printf("===== 보드 프로필 =====\n");
+    check(RelayPin::port == GPIO_PORT_D && RelayPin::mask == 0x40, "릴레이 D6 = PORTD 비트 6");
+    check(ServoPin::port == GPIO_PORT_B && ServoPin::mask == 0x02, "서보 D9 = PORTB 비트 1 (OC1A)");
+    check(StatusLed::port == GPIO_PORT_B && StatusLed::mask == 0x20, "LED D13 = PORTB 비트 5");
+    check(RainSensor::channel == 0 && WaterLevelSensor::channel == 3 && TempSensor::channel == 4,
+          "아날로그 핀 ADC 채널");
+
+    hal::native::reset();
+    StatusLed::output();
+    StatusLed::high();
+    bool on = hal::native::pinLevel(STATUS_LED_PIN) == HIGH && StatusLed::read();
+    StatusLed::toggle();
+    check(on && !StatusLed::read(), "네이티브에서는 가상 핀으로 쓰기/읽기/토글");
+}
+
+// KY-013 표 보간을 Steinhart-Hart 식(double)과 비교
+double ky013Reference(uint16_t raw) {
+    double ln = std::log(KY013_SERIES_OHMS * (ADC_MAX / (double)raw - 1.0));
+    return 1.0 / (KY013_SH_A + KY013_SH_B * ln + KY013_SH_C * ln * ln * ln) - 273.15;
+}
+
+void ky013() {
+    printf("===== KY-013 온도 표 =====\n");
+    double worst = 0;
+    uint16_t worstRaw = 0, lowRaw = 0, highRaw = 0;
+    bool monotonic = true;
+    for (uint16_t raw = 1; raw < ADC_MAX; raw++) {
+        double expected = ky013Reference(raw);
+        double actual = ky013ToCelsius(raw).q / 256.0;
+        if (ky013ToCelsius(raw).q < ky013ToCelsius(raw - 1).q) monotonic = false;
+        if (expected < 0 || expected > 60) continue;
+        if (!lowRaw) lowRaw = raw;
+        highRaw = raw;
+        if (std::fabs(actual - expected) > worst) {
+            worst = std::fabs(actual - expected);
+            worstRaw = raw;
+        }
+    }
+    printf("  0~60°C (원시값 %u~%u) 최대 오차 %.3f°C (원시값 %u)\n", lowRaw, highRaw, worst, worstRaw);
+    check(worst < 0.05, "0~60°C에서 식과 0.05°C 이내");
+    check(monotonic, "원시값이 커지면 온도도 오름 (포텐셔미터와 같은 방향)");
+    check(ky013ToCelsius(0).q == KY013_TABLE[0] && ky013ToCelsius(2000).q == 32767, "양 끝은 표 끝값/포화");
+
+    // 컴파일 타임 역변환: raw > 경계 이면 c 초과
+    constexpr uint16_t boundary = ky013RawForCelsius(28.0);
+    static_assert(ky013TableQ(boundary) <= 28 * 256 && ky013TableQ(boundary + 1) > 28 * 256,
+                  "ky013RawForCelsius boundary");
+    printf("  28.0°C 경계 원시값 %u (%.2f°C / %.2f°C)\n", boundary,
+           ky013ToCelsius(boundary).q / 256.0, ky013ToCelsius(boundary + 1).q / 256.0);
+    check(ky013ToCelsius(boundary + 1).q > 28 * 256 && ky013ToCelsius(boundary).q <= 28 * 256,
+          "컴파일 타임 임계값 경계");
+}
+
+// DHT 프레임 5바이트를 하강 에지 42개의 시각으로 (0 = 78us, 1 = 120us 간격)
+void dhtFeedFrame(DhtSensor& sensor, const uint8_t* bytes) {
+    unsigned long t = hal::micros() + 30;
+    sensor.onFallingEdge(t);        // 응답 LOW 시작
+    t += 160;
+    sensor.onFallingEdge(t);        // 응답 HIGH 끝 = 첫 비트 시작
+    for (uint8_t bit = 0; bit < 40; bit++) {
+        t += (bytes[bit >> 3] & (0x80 >> (bit & 7))) ? 120 : 78;
+        sensor.onFallingEdge(t);
+    }
+}
+
+void dhtFrame22(uint8_t* bytes, uint16_t humidityTenths, int16_t tempTenths) {
+    uint16_t t = tempTenths < 0 ? (uint16_t)(0x8000 | -tempTenths) : (uint16_t)tempTenths;
+    bytes[0] = (uint8_t)(humidityTenths >> 8);
+    bytes[1] = (uint8_t)humidityTenths;
+    bytes[2] = (uint8_t)(t >> 8);
+    bytes[3] = (uint8_t)t;
+    bytes[4] = (uint8_t)(bytes[0] + bytes[1] + bytes[2] + bytes[3]);
+}
+
+// 제어 루프를 돌리다가 전역 DHT가 선을 놓으면 그 자리에서 응답
+bool dhtRespond(uint16_t humidityTenths, int16_t tempTenths) {
+    if (runUntil([] { return dht.receiving(); }, 3000) > 3000) return false;
+    uint8_t bytes[DHT_FRAME_BYTES];
+    dhtFrame22(bytes, humidityTenths, tempTenths);
+    dhtFeedFrame(dht, bytes);
+    uint16_t reads = dht.stats().reads;
+    runFor(1);
+    return dht.stats().reads == reads + 1;
+}
+
+void dhtSensor() {
+    printf("===== DHT 온습도 =====\n");
+    uint8_t bytes[DHT_FRAME_BYTES];
+    Celsius t;
+    Percent h;
+
+    dhtFrame22(bytes, 652, 284);
+    bool ok = DhtSensor::decode(bytes, DHT_MODEL_22, t, h);
+    check(ok && h.tenths() == 652 && t.tenths() == 284, "DHT22 프레임 65.2% / 28.4°C");
+    dhtFrame22(bytes, 300, -101);
+    ok = DhtSensor::decode(bytes, DHT_MODEL_22, t, h);
+    check(ok && t.tenths() == -101, "DHT22 영하 (부호 비트)");
+    bytes[4] ^= 0x01;
+    check(!DhtSensor::decode(bytes, DHT_MODEL_22, t, h), "체크섬이 틀리면 버림");
+    const uint8_t dht11[DHT_FRAME_BYTES] = { 55, 0, 24, 3, 82 };
+    ok = DhtSensor::decode(dht11, DHT_MODEL_11, t, h);
+    check(ok && h.tenths() == 550 && t.tenths() == 243, "DHT11 프레임 55% / 24.3°C");
+
+    // 상태 기계: 시작 신호 LOW 유지 → 선 놓기 → 에지 42개 → 해석
+    hal::native::reset();
+    DhtSensor sensor(DHT_MODEL_22);
+    sensor.begin();
+    unsigned long startedAt = 0, releasedAt = 0;
+    for (unsigned long ms = 0; ms < 3000 && !sensor.receiving(); ms++) {
+        hal::native::advance(1);
+        sensor.poll();
+        if (!startedAt && hal::native::pinLevel(DHT_PIN) == LOW &&
+            hal::native::digitalWrites(DHT_PIN) > 0) startedAt = hal::millis();
+    }
+    releasedAt = hal::millis();
+    printf("  첫 시작 신호 %lu ms, LOW 유지 %lu ms\n", startedAt, releasedAt - startedAt);
+    check(startedAt >= 1000 && releasedAt - startedAt >= 1 && releasedAt - startedAt < 18,
+          "전원 안정 1초 뒤 시작, DHT22 시작 신호 1ms 이상");
+
+    dhtFrame22(bytes, 481, 312);
+    dhtFeedFrame(sensor, bytes);
+    hal::native::advance(1);
+    check(sensor.poll() && sensor.humidity().tenths() == 481 && sensor.temperature().tenths() == 312,
+          "에지 간격으로 40비트 복원");
+    check(sensor.stats().reads == 1 && !sensor.receiving(), "한 프레임 뒤 대기 상태");
+
+    // 2초 뒤 다음 측정. 센서가 응답하지 않으면 시간 초과로 포기하고 다음 주기에 다시
+    unsigned long waited = 0;
+    while (!sensor.receiving() && waited++ < 3000) {
+        hal::native::advance(1);
+        sensor.poll();
+    }
+    for (uint8_t ms = 0; ms < 20; ms++) {
+        hal::native::advance(1);
+        sensor.poll();
+    }
+    check(waited >= 1990 && sensor.stats().timeouts == 1 && !sensor.receiving(), "응답 없으면 10ms 뒤 시간 초과");
+    check(sensor.valid() && sensor.humidity().tenths() == 481, "실패해도 마지막 값 유지");
+
+    // 체감 온도 (Steadman)
+    Celsius at = apparentTemperature(Celsius::fromQ(28 * Q_ONE), Percent::fromQ(60 * Q_ONE));
+    Celsius dry = apparentTemperature(Celsius::fromQ(28 * Q_ONE), Percent::fromQ(20 * Q_ONE));
+    printf("  28°C 체감: 습도 60%% %.2f°C, 20%% %.2f°C\n", at.q / 256.0, dry.q / 256.0);
+    check(std::fabs(at.q / 256.0 - 31.46) < 0.1 && std::fabs(dry.q / 256.0 - 26.49) < 0.1,
+          "체감 온도가 식과 0.1°C 이내");
+    Celsius shorted = apparentTemperature(Celsius::fromQ(INT16_MAX), Percent::fromQ(90 * Q_ONE));
+    Celsius frozen = apparentTemperature(Celsius::fromQ(INT16_MIN), Percent::fromQ(0));
+    check(shorted.q == INT16_MAX && frozen.q == INT16_MIN, "표 끝 온도는 감기지 않고 끝값 (NTC 단락)");
+
+    // 습한 날: 기온 26°C(더위 경계 아래)라도 습도 80%면 더위 모드
+    boot();
+    setInputs(temperatureRawForCelsius(26.0), 900, 700);
+    runFor(DWELL_HEAT_ENTER * 1000UL + 1000);
+    check(status.operationMode == MODE_STANDBY && !sensors.humidityValid, "습도 없이 26°C → 대기");
+    bool responded = true;
+    for (uint8_t i = 0; i < 5; i++) responded &= dhtRespond(800, 260);
+    runFor(100);
+    printf("  26°C / 80%% → 체감 %.1f°C\n", sensors.heatIndex.q / 256.0);
+    check(responded && sensors.humidityValid && status.operationMode == MODE_HEAT, "습한 26°C → 더위 모드");
+
+    // 건조한 날: 29°C라도 습도 10%면 체감 26°C대 → 더위 해제
+    setInputs(temperatureRawForCelsius(29.0), 900, 700);
+    for (uint8_t i = 0; i < 20; i++) dhtRespond(100, 290);
+    runFor(100);
+    printf("  29°C / 10%% → 체감 %.1f°C\n", sensors.heatIndex.q / 256.0);
+    check(status.operationMode == MODE_STANDBY, "건조한 29°C → 대기 모드");
+
+    // DHT가 끊기면 온도만으로 (29°C > 28°C)
+    runFor(HUMIDITY_STALE_MS + DWELL_HEAT_ENTER * 1000UL + 1000);
+    check(!sensors.humidityValid && status.operationMode == MODE_HEAT, "습도 끊기면 온도만으로 더위 판단");
+    check(dht.stats().timeouts > 0 && dht.stats().checksumErrors == 0, "응답 없는 측정은 시간 초과로 집계");
+}
+
+// 하드웨어 PWM 펄스 폭은 Servo 라이브러리와 같은 각도 사상
+void servoPulse() {
+    printf("===== 서보 펄스 =====\n");
+    check(servoPulseMicros(0) == 544 && servoPulseMicros(180) == 2400 && servoPulseMicros(200) == 2400,
+          "0도 544us, 180도 2400us, 범위 밖은 180도");
+    check(servoPulseMicros(ANGLE_STOWED) == 853 && servoPulseMicros(ANGLE_SHADE) == 1368 &&
+          servoPulseMicros(ANGLE_COLLECT) == 1884, "수납/차양/수집 각도 펄스 폭");
+    uint16_t ticks = SERVO_PERIOD_MICROS * SERVO_TICKS_PER_MICRO;
+    check(ticks == 40000 && SERVO_MAX_MICROS * SERVO_TICKS_PER_MICRO < ticks, "20ms 주기, 0.5us 단위");
+}
+
+void telemetry() {
+    printf("===== 텔레메트리 =====\n");
+    boot();
+    setInputs(800, 900, 700);
+    runFor(DWELL_HEAT_ENTER * 1000UL + 1000);
+
+    TelemetryRecord sent;
+    fillTelemetry(sent);
+    sent.type = TELEMETRY_STATUS;
+    sent.sequence = 254;
+
+    uint8_t frame[TELEMETRY_FRAME_MAX];
+    uint8_t length = encodeTelemetryFrame(sent, frame);
+    printf("  프레임 길이: %u 바이트\n", length);
+    check(length <= TELEMETRY_FRAME_MAX && frame[length - 1] == 0, "프레임은 0x00 하나로 끝남");
+    bool zeroInside = false;
+    for (uint8_t i = 0; i + 1 < length; i++) zeroInside |= (frame[i] == 0);
+    check(!zeroInside, "프레임 안에 0x00 없음 (COBS)");
+
+    // 앞에 텍스트가 섞여 있어도 다음 구분자에서 동기를 맞춘다
+    TelemetryDecoder decoder;
+    const char* noise = "=== SmartCool Parasol ===\r\n";
+    for (const char* p = noise; *p; p++) decoder.feed((uint8_t)*p);
+    decoder.feed(0);
+    bool decoded = false;
+    for (uint8_t i = 0; i < length; i++) decoded = decoder.feed(frame[i]);
+    const TelemetryRecord& got = decoder.record();
+    check(decoded && got.sequence == 254 && got.operationMode == MODE_HEAT
+          && got.temperatureQ == sensors.temperature.q
+          && got.waterLevelRaw == sensors.waterLevelRaw
+          && (got.flags & TFLAG_PUMP_ACTIVE) && (got.flags & TFLAG_HEAT_DETECTED),
+          "인코딩 → 디코딩 왕복 일치");
+    check(got.heatIndexQ == sensors.heatIndex.q && got.humidityQ == sensors.humidity.q &&
+          ((got.flags & TFLAG_HUMIDITY_VALID) != 0) == sensors.humidityValid, "습도/체감 온도 필드");
+
+    // 더위 판단이 체감 온도 기준일 때 호스트가 근거를 볼 수 있게 (버전 2)
+    TelemetryRecord humid = sent;
+    humid.humidityQ = (uint16_t)(852 * Q_ONE / 10);
+    humid.heatIndexQ = (int16_t)(-123 * Q_ONE / 10);
+    humid.flags |= TFLAG_HUMIDITY_VALID;
+    uint8_t humidFrame[TELEMETRY_FRAME_MAX];
+    uint8_t humidLength = encodeTelemetryFrame(humid, humidFrame);
+    TelemetryDecoder humidDecoder;
+    decoded = humidDecoder.decode(humidFrame, humidLength - 1);
+    check(decoded && humidDecoder.record().humidityQ == humid.humidityQ &&
+          humidDecoder.record().heatIndexQ == humid.heatIndexQ &&
+          (humidDecoder.record().flags & TFLAG_HUMIDITY_VALID), "습도 유효 비트와 음수 체감 온도 왕복");
+    check(humidLength == TELEMETRY_FRAME_MAX && TELEMETRY_VERSION == 2, "버전 2 프레임 31바이트");
+
+    // 한 바이트가 깨지면 CRC로 거르고, 다음 프레임은 정상 수신 (sequence 255 유실 집계)
+    frame[5] ^= 0x10;
+    for (uint8_t i = 0; i < length; i++) decoder.feed(frame[i]);
+    sent.sequence = 0;
+    length = encodeTelemetryFrame(sent, frame);
+    for (uint8_t i = 0; i < length; i++) decoded = decoder.feed(frame[i]);
+    const TelemetryDecoder::Counters& st = decoder.counters();
+    check(st.crcErrors + st.framingErrors == 2, "텍스트 잡음과 손상 프레임은 오류로 집계");
+    check(decoded && st.frames == 2 && st.lostFrames == 1, "손상 뒤 재동기, 유실 1 프레임");
+}
+
+void logger() {
+    printf("===== 로거 =====\n");
+    boot();
+    logResetStats();
+
+    // 시간이 흐르지 않는 동안 계속 쓰면 TX 링이 차고, 그 뒤 줄은 기다리지 않고 버린다
+    unsigned long before = hal::millis();
+    for (int i = 0; i < 40; i++) {
+        LOG_INFO(F("온도: "), tenths(-5), F("°C | 비: "), i);
+    }
+    const LogStats& st = logStats();
+    printf("  전송 %lu 줄, 버림 %lu 줄 (%lu 바이트)\n", st.written, st.dropped, st.droppedBytes);
+    check(hal::millis() == before, "로그 호출은 블로킹하지 않음");
+    check(st.written > 0 && st.dropped > 0 && st.written + st.dropped == 40, "TX 링이 차면 줄 단위로 버리고 셈");
+    const std::string first = "온도: -0.5°C | 비: 0\r\n";
+    check(hal::native::serialOutput().compare(0, first.size(), first) == 0, "줄 내용과 음수 소수 표기");
+    check(hal::serialWritable() < LOG_LINE_MAX, "TX 링 가득 참");
+
+    // UART가 비워 주면 다시 받는다
+    hal::native::advance(300);
+    check(LOG_INFO(F("다시 전송")), "TX 링이 비면 다시 전송");
+
+    // 너무 긴 줄은 잘라서 보낸다
+    logResetStats();
+    hal::native::advance(300);
+    LOG_INFO(F("0123456789012345678901234567890123456789012345678901234567890123456789"),
+             F("0123456789012345678901234567890123456789"));
+    check(logStats().truncated == 1 && logStats().written == 1, "LOG_LINE_MAX를 넘는 줄은 잘라서 전송");
+
+    // 형식 문자열: {} 자리에 타입별 출력, 남는 리터럴 유지
+    hal::native::advance(300);
+    hal::native::clearSerialOutput();
+    LOGF_INFO("   온도: {}°C (Raw: {}) {}", tenths(-123), 512, F("[정상]"));
+    LOGF_INFO("모드 {}/{} {}", 2u, -7L, 'x');
+    LOGF_INFO("인자 없음");
+    check(hal::native::serialOutput() ==
+          "   온도: -12.3°C (Raw: 512) [정상]\r\n모드 2/-7 x\r\n인자 없음\r\n",
+          "형식 문자열 출력");
+    static_assert(formatPlaceholders("a {} b {} c") == 2, "{} 개수는 컴파일 타임에 센다");
+}
+
+// 증분 필터: 창이 덜 찬 동안의 값, 창 밖으로 밀린 샘플, 튀는 값, 수렴
+void filters() {
+    printf("===== 필터 =====\n");
+    MovingAverage<uint16_t, 4, uint16_t> average;
+    check(average.push(100) == 100 && average.push(200) == 150 && !average.full(),
+          "이동 평균: 첫 샘플부터 유효");
+    average.push(300);
+    average.push(400);
+    check(average.full() && average.value() == 250 && average.push(1000) == 475,
+          "이동 평균: 가장 오래된 샘플을 빼고 누적합 갱신");
+
+    MovingAverage<int16_t, 3> signedAverage;
+    signedAverage.push(-30);
+    signedAverage.push(-60);
+    check(signedAverage.push(30) == -20, "이동 평균: 음수 샘플");
+
+    SlidingMedian<uint16_t, 5> median;
+    const uint16_t rain[] = { 800, 810, 1023, 805, 0, 790, 300, 310, 305 };
+    uint16_t maxSeen = 0, minSeen = 0xFFFF;
+    for (uint8_t i = 0; i < 6; i++) {
+        uint16_t v = median.push(rain[i]);
+        if (i >= 2) {
+            if (v > maxSeen) maxSeen = v;
+            if (v < minSeen) minSeen = v;
+        }
+    }
+    check(maxSeen <= 810 && minSeen >= 790, "중앙값: 1023/0 튐은 결과에 안 나옴");
+    median.push(rain[6]);
+    median.push(rain[7]);
+    check(median.push(rain[8]) == 305, "중앙값: 창의 과반이 바뀌면 따라감");
+
+    Kalman1D<uint16_t, 1, 16> kalman;
+    check(kalman.push(500) == 500, "칼만: 첫 샘플 그대로");
+    unsigned steps = 0;
+    while (kalman.push(700) < 690 && steps < 100) steps++;
+    printf("  칼만 계단 응답: 500 → 700, 95%% 도달 %u 샘플, 이득 %u/256\n", steps, kalman.gain());
+    check(steps > 3 && steps < 30, "칼만: 계단 입력에 수십 샘플 안에 수렴");
+    for (int i = 0; i < 200; i++) kalman.push(700);
+    check(kalman.value() == 700 && kalman.gain() > 30 && kalman.gain() < 100,
+          "칼만: 정상 상태 오차 0, 이득 약 sqrt(Q/R)");
+    unsigned jitter = 0;
+    for (int i = 0; i < 200; i++) {
+        uint16_t v = kalman.push(i & 1 ? 708 : 692);
+        unsigned d = v > 700 ? v - 700 : 700 - v;
+        if (d > jitter) jitter = d;
+    }
+    check(jitter <= 3, "칼만: ±8 잡음을 ±3 이내로");
+}
+
+// 채널별 주기/신선도 마감. 가짜 시계와 읽기 함수로 레지스트리만 따로 돌린다
+unsigned long registryNow = 0;
+bool registryReadOk[3] = { true, true, true };
+unsigned long registryClock() { return registryNow; }
+bool registryRead(uint8_t source, uint16_t& raw) {
+    raw = (uint16_t)(100 * (source + 1));
+    return registryReadOk[source];
+}
+uint16_t registryDouble(uint16_t raw) { return (uint16_t)(raw * 2); }
+
+void registry() {
+    printf("===== 센서 레지스트리 =====\n");
+    SensorChannel channels[] = {
+        SENSOR_CHANNEL(0, registryDouble, 20, 200),
+        SENSOR_CHANNEL(1, 0, 100, 1000),
+        SENSOR_CHANNEL(2, 0, 250, 2000),
+    };
+    SensorRegistry reg(channels, 3, registryClock, registryRead);
+    reg.begin();
+    check(reg.staleMask() == 0x7, "begin 직후에는 모든 채널 값 없음");
+
+    uint8_t fastOnly = 0;
+    for (registryNow = 0; registryNow < 1000; registryNow++) {
+        if (reg.poll() == 0x1) fastOnly++;
+    }
+    printf("  1초 샘플 수: %u / %u / %u\n", reg.channel(0).samples, reg.channel(1).samples,
+           reg.channel(2).samples);
+    check(reg.channel(0).samples == 50 && reg.channel(1).samples == 10 && reg.channel(2).samples == 4,
+          "채널마다 자기 주기로 샘플링");
+    check(fastOnly == 40, "빠른 채널은 느린 채널 없이 단독 갱신");
+    check(reg.value(0) == 200 && reg.value(2) == 300 && reg.allFresh(), "필터 출력/원시값 그대로");
+
+    // 느린 채널 읽기가 끊기면 그 채널만 마감 뒤 stale
+    registryReadOk[2] = false;
+    for (; registryNow < 2000; registryNow++) reg.poll();
+    check(reg.staleMask() == 0, "마감 전에는 stale 아님");
+    for (; registryNow < 3000; registryNow++) reg.poll();
+    check(reg.staleMask() == 0x4 && reg.fresh(0) && reg.fresh(1), "끊긴 채널만 stale");
+    registryReadOk[2] = true;
+    reg.poll();
+    check(reg.staleMask() == 0, "값이 다시 들어오면 바로 회복");
+
+    // 한참 멈췄다 돌아와도 밀린 샘플을 몰아서 읽지 않는다
+    uint16_t before = reg.channel(0).samples;
+    registryNow += 5000;
+    reg.poll();
+    registryNow += 1;
+    reg.poll();
+    check(reg.channel(0).samples == before + 1, "밀린 주기는 따라잡지 않고 재정렬");
+}
+
+// 카탈로그 메시지 텍스트 펼침, 프레임 왕복, 텍스트 대비 바이트 수
+void messages() {
+    printf("===== 카탈로그 메시지 =====\n");
+    boot();
+    hal::native::advance(300);
+    hal::native::clearSerialOutput();
+    LOGM_INFO(MSG_STATUS_TEMP_RAIN, tenths(285), true, 850, false);
+    LOGM_INFO(MSG_MODE_CHANGED, 7);
+    LOGM_INFO(MSG_PUMP_STARTED);
+    check(hal::native::serialOutput() ==
+          "온도: 28.5°C [더위감지] | 비: 850 [없음]\r\n? 모드\r\n미스트 분사 시작\r\n",
+          "텍스트 빌드: 자리 표시/선택지/범위 밖 선택지");
+    static_assert(MessageText<MSG_STATUS_PARASOL_MOVE>::args == 3, "자리 표시 개수는 컴파일 타임에 센다");
+
+    const int32_t args[] = { -123, 100000, 0, 63, -64 };
+    uint8_t frame[MESSAGE_FRAME_MAX];
+    uint8_t length = encodeMessageFrame(MSG_PROF_STAGE, args, 5, frame);
+    uint8_t raw[MESSAGE_FRAME_MAX];
+    size_t rawLength = cobsDecode(frame, length - 1, raw);
+    MessageRecord got;
+    bool ok = decodeMessagePayload(raw, rawLength, got);
+    check(ok && got.id == MSG_PROF_STAGE && got.count == 5 && got.args[0] == -123
+          && got.args[1] == 100000 && got.args[3] == 63 && got.args[4] == -64,
+          "프레임 인코딩 → 디코딩 왕복 일치");
+    raw[2] ^= 0x04;
+    check(!decodeMessagePayload(raw, rawLength, got), "손상 프레임은 CRC8로 거름");
+    check(decodeMessagePayload(raw, 0, got) == false && messageCatalogText(MSG_COUNT) == 0,
+          "빈 프레임/없는 번호");
+    length = encodeMessageFrame(MSG_CT_TOTAL_TIME, args, 1, frame);
+    rawLength = cobsDecode(frame, length - 1, raw);
+    check(decodeMessagePayload(raw, rawLength, got) && got.id == MSG_CT_TOTAL_TIME && got.args[0] == -123,
+          "64번 이상 번호는 2바이트");
+
+    // 텍스트 뒤 첫 프레임만 구분자를 하나 더 붙인다
+    hal::native::clearSerialOutput();
+    LOG_INFO(F("부팅"));
+    messageSend(MSG_PUMP_STARTED, args, 0);
+    messageSend(MSG_PUMP_STARTED, args, 0);
+    const std::string& out = hal::native::serialOutput();
+    check(out.size() == 8 + 1 + 4 + 4 && out[8] == 0 && out[9] != 0 && out[13] != 0,
+          "텍스트와 프레임 사이 구분자");
+
+    // 호스트 도구의 스트림 분리: COBS 코드 바이트가 0x0A인 프레임도 텍스트 줄로 자르지 않는다
+    const int32_t overruns[] = { 12, 1234, 553, 301, 1, 0 };
+    length = encodeMessageFrame(MSG_PROF_OVERRUNS, overruns, 6, frame);
+    std::string stream = "=== SmartCool Parasol ===\r\n";
+    stream += '\0';
+    stream.append((const char*)frame, length);
+    stream += "텍스트\r\n";
+    LogStreamSplitter splitter;
+    std::vector<std::string> texts;
+    std::vector<std::string> blocks;
+    for (char c : stream) {
+        LogStreamSplitter::Chunk chunk = splitter.feed((uint8_t)c);
+        std::string piece((const char*)splitter.data(), splitter.size());
+        if (chunk == LogStreamSplitter::CHUNK_TEXT) texts.push_back(piece);
+        if (chunk == LogStreamSplitter::CHUNK_BLOCK) blocks.push_back(piece);
+    }
+    ok = blocks.size() == 1 && (rawLength = cobsDecode((const uint8_t*)blocks[0].data(), blocks[0].size(), raw)) &&
+         decodeMessagePayload(raw, rawLength, got) && got.id == MSG_PROF_OVERRUNS && got.args[1] == 1234;
+    check(frame[0] == '\n' && ok && texts.size() == 2 && texts[1] == "텍스트\r\n",
+          "코드 바이트 0x0A 프레임을 텍스트 줄로 자르지 않음");
+
+    // 모든 메시지가 최악의 인자로도 한 줄(LOG_LINE_MAX)에 들어간다.
+    // 카운터는 16비트라 {}는 65535, {.1}은 -3276.8, 선택지는 번호를 하나씩 돌린다
+    unsigned longest = 0;
+    int longestId = -1;
+    bool fits = true;
+    for (uint16_t id = 0; id < MSG_COUNT; id++) {
+        const char* text = messageCatalogText(id);
+        for (int32_t option = 0; option < 8; option++) {
+            int32_t worst[MESSAGE_ARGS_MAX];
+            uint8_t count = 0;
+            for (const char* p = text; *p && count < MESSAGE_ARGS_MAX; p++) {
+                if (*p != '{') continue;
+                worst[count++] = p[1] == '}' ? 65535 : p[1] == '.' ? -32768 : option;
+            }
+            LogLine line;
+            messageExpand(line, text, worst, count);
+            if (line.truncated()) {
+                printf("  잘림: #%u %s\n", (unsigned)id, text);
+                fits = false;
+                break;
+            }
+            if (line.size() > longest) {
+                longest = line.size();
+                longestId = id;
+            }
+        }
+    }
+    printf("  가장 긴 줄: #%d %u 바이트 (한도 %u)\n", longestId, longest, (unsigned)LOG_LINE_MAX - 2);
+    check(fits, "최악의 인자로 펼쳐도 잘리는 카탈로그 메시지 없음");
+
+    // 상태 보고 한 번 (printStatusLine과 같은 메시지/인자)
+    struct Sample { MessageId id; uint8_t count; int32_t args[4]; };
+    const Sample report[] = {
+        { MSG_STATUS_HEADER, 0, { 0 } },
+        { MSG_STATUS_TEMP_RAIN, 4, { 315, 1, 850, 0 } },
+        { MSG_STATUS_WATER, 2, { 734, 1 } },
+        { MSG_STATUS_PARASOL, 1, { 1 } },
+        { MSG_STATUS_PUMP_MODE, 2, { 1, 2 } },
+        { MSG_STATUS_COMMANDS, 4, { 12, 3400, 8, 51000 } },
+        { MSG_STATUS_LOG, 4, { 1520, 3, 150, 0 } },
+        { MSG_STATUS_SRAM, 3, { 410, 355, 190 } },
+        { MSG_REPORT_FOOTER, 0, { 0 } },
+        { MSG_MODE_CHANGED, 1, { 2 } },
+        { MSG_PUMP_STARTED, 0, { 0 } },
+    };
+    unsigned textBytes = 0;
+    unsigned frameBytes = 0;
+    for (const Sample& m : report) {
+        LogLine line;
+        messageExpand(line, messageCatalogText(m.id), m.args, m.count);
+        textBytes += line.size() + 2;
+        frameBytes += encodeMessageFrame(m.id, m.args, m.count, frame);
+    }
+    printf("  상태 보고 + 이벤트: 텍스트 %u 바이트 → 프레임 %u 바이트 (%.1f배)\n",
+           textBytes, frameBytes, (double)textBytes / frameBytes);
+    check(frameBytes * 5 < textBytes, "카탈로그 프레임은 텍스트의 1/5 미만");
+}
+
+void profiler() {
+    printf("===== 실행 시간 계측 =====\n");
+    boot();
+    profileReset();
+    setInputs(800, 900, 700);
+    runFor(2000);
+
+    const StageStats& loop = profileStage(STAGE_LOOP);
+    check(loop.count == 1999 && loop.minUs == 1000 && loop.maxUs == 1000, "루프 간격 1ms 기록");
+    check(profileLoopOverruns() == 0, "루프 간격 예산 초과 없음");
+    check(profileStage(STAGE_SENSE).count == 100 && profileStage(STAGE_MODE).count >= 20,
+          "센싱/모드 단계 호출 횟수");
+    check(profileStage(STAGE_PARASOL).count == profileStage(STAGE_PUMP).count, "파라솔/펌프 단계는 함께 실행");
+
+    // 구간 경계와 포화 시 절반 축소
+    profileReset();
+    profileRecord(STAGE_MODE, 15);
+    profileRecord(STAGE_MODE, 16);
+    profileRecord(STAGE_MODE, 100000);
+    const StageStats& mode = profileStage(STAGE_MODE);
+    check(mode.buckets[0] == 1 && mode.buckets[1] == 1 && mode.buckets[PROFILE_BUCKETS - 1] == 1,
+          "로그 구간 경계 (<16, <32, 마지막 구간)");
+    check(mode.maxUs == 0xFFFF && mode.minUs == 15, "최대값은 65535us에서 포화");
+    for (int i = 0; i < 300; i++) profileRecord(STAGE_MODE, 20);
+    check(mode.buckets[1] > 100 && mode.buckets[1] < 255 && mode.buckets[0] == 0,
+          "구간 포화 시 전체를 절반으로 줄임");
+    check(profileMeanUs(STAGE_MODE) > 0 && mode.count == 303, "평균/횟수 유지");
+
+    // 블로킹 구간은 루프 간격 초과로 잡힌다
+    profileReset();
+    runFor(10);
+    hal::native::advance(20);
+    runFor(10);
+    check(profileLoopOverruns() == 1 && profileStage(STAGE_LOOP).maxUs == 21000, "20ms 블로킹을 지터로 검출");
+}
+
+// 비 시작 → 파라솔 명령 지연. 50us 단위로 시계를 돌리고 비 시작 시점을 변환 주기 안에서 흔든다
+unsigned long measureRainOnset(unsigned long& minUs, unsigned long& maxUs) {
+    const int TRIALS = 20;
+    unsigned long total = 0;
+    minUs = 0xFFFFFFFFUL;
+    maxUs = 0;
+    for (int i = 0; i < TRIALS; i++) {
+        setInputs(400, 900, 700);
+        runFor(DWELL_RAIN_EXIT * 1000UL + 2000);    // 대기 모드, 수납 완료
+        hal::native::advanceMicros(37UL * i);
+
+        setInputs(400, 300, 700);
+        unsigned long us = 0;
+        while (parasolMotion.target() != ANGLE_COLLECT && us < 1000000UL) {
+            hal::native::advanceMicros(50);
+            controlTick();
+            us += 50;
+        }
+        total += us;
+        if (us < minUs) minUs = us;
+        if (us > maxUs) maxUs = us;
+    }
+    return total / TRIALS;
+}
+
+void rainOnset() {
+    printf("===== 비 시작 지연 =====\n");
+    boot();
+    unsigned long minUs, maxUs;
+    unsigned long fastAvg = measureRainOnset(minUs, maxUs);
+    printf("  창 비교 빠른 경로: 최소 %lu / 평균 %lu / 최대 %lu us\n", minUs, fastAvg, maxUs);
+    printf("  ISR 감지 → 명령: 최근 %u / 최대 %u us, 선점 %u 회\n", rainOnsetStats.lastMicros,
+           rainOnsetStats.maxMicros, rainOnsetStats.preemptions);
+    check(maxUs <= 5000, "비 시작 후 5ms 이내 빗물 수집 각도 명령");
+    check(rainOnsetStats.preemptions == 20 && rainOnsetStats.trips == 20, "비 시작 한 번에 선점 한 번");
+
+    adcSampler.clearWindow();
+    unsigned long slowMin, slowMax;
+    unsigned long slowAvg = measureRainOnset(slowMin, slowMax);
+    printf("  필터 + 센싱 주기 경로: 최소 %lu / 평균 %lu / 최대 %lu us\n", slowMin, slowAvg, slowMax);
+    check(fastAvg * 4 < slowAvg, "빠른 경로가 필터 경로보다 4배 이상 빠름");
+
+    // 변환 한 번짜리 튐은 확인 횟수에 못 미쳐 무시
+    boot();
+    setInputs(400, 900, 700);
+    runFor(1000);
+    setInputs(400, 300, 700);
+    hal::native::advanceMicros(300);
+    controlTick();
+    setInputs(400, 900, 700);
+    runFor(1000);
+    check(rainOnsetStats.trips == 0 && status.operationMode != MODE_RAIN, "변환 한 번의 튐은 무시");
+}
+
+// src/main.cpp의 setup()과 같은 순서. systemReady는 자가 진단 캐시가 정한다
+SelfTestEvent lastSelfTestEvent = SELFTEST_EVENT_NONE;
+int selfTestAborts = 0;
+
+void bootWithSelfTest() {
+    hal::native::reset();
+    initializeSystem();
+    initializePins();
+    initializeActuators();
+    selfTest.begin();
+    controlBegin(hooks);
+    lastSelfTestEvent = SELFTEST_EVENT_NONE;
+    selfTestAborts = 0;
+}
+
+// loop()처럼 제어 틱과 진단을 번갈아
+template <typename Predicate>
+unsigned long runWithSelfTestUntil(Predicate done, unsigned long limit) {
+    for (unsigned long ms = 0; ms <= limit; ms++) {
+        if (done()) return ms;
+        hal::native::advance(1);
+        controlTick();
+        SelfTestEvent event = selfTest.poll();
+        if (event != SELFTEST_EVENT_NONE) lastSelfTestEvent = event;
+        if (event == SELFTEST_EVENT_ABORTED) selfTestAborts++;
+    }
+    return limit + 1;
+}
+
+void selfTestBoot() {
+    printf("===== 부팅 자가 진단 =====\n");
+
+    // 기록 없음: 제어는 진단이 끝날 때까지 대기, 블로킹 없이 진행
+    hal::native::eraseEeprom();
+    setInputs(400, 900, 700);
+    bootWithSelfTest();
+    check(!selfTest.cached() && !status.systemReady, "기록 없으면 진단 전 systemReady 꺼짐");
+    unsigned long doneMs = runWithSelfTestUntil([] { return selfTest.done(); }, 15000);
+    printf("  진단 소요: %lu ms (서보 왕복 %u ms)\n", doneMs, selfTest.record().sweepMs);
+    check(doneMs < 15000 && selfTest.result() == SELFTEST_ALL, "진단 전 항목 통과");
+    check(status.systemReady, "진단이 끝나면 systemReady");
+    check(hal::native::servoAngle() == ANGLE_STOWED && hal::native::pinLevel(RELAY_PIN) == LOW,
+          "진단 후 수납, 펌프 OFF");
+    // 기록은 EEPROM이 준비될 때마다 한 바이트씩. 루프는 한 번도 기다리지 않는다
+    unsigned long savingFrom = hal::micros();
+    unsigned long saveMs = runWithSelfTestUntil([] { return !selfTest.saving(); }, 1000);
+    printf("  기록 저장: %lu ms\n", saveMs);
+    check(saveMs > 0 && saveMs < 100 && hal::micros() - savingFrom == saveMs * 1000UL,
+          "완료 후 기록 저장은 루프를 막지 않음");
+    SelfTestRecord saved;
+    check(loadSelfTestRecord(saved) && saved.result == SELFTEST_ALL && saved.runs == 1,
+          "결과를 EEPROM에 CRC와 함께 저장");
+
+    // 캐시 통과: 리셋 직후 비가 와도 100ms 안에 빗물 수집 각도 명령
+    setInputs(400, 300, 700);
+    bootWithSelfTest();
+    check(selfTest.cached() && status.systemReady, "캐시가 모두 통과면 바로 systemReady");
+    unsigned long rainMs = runWithSelfTestUntil([] { return parasolMotion.target() == ANGLE_COLLECT; }, 1000);
+    printf("  리셋 → 비 대응 명령: %lu ms\n", rainMs);
+    check(rainMs < 100, "리셋 후 100ms 안에 제어");
+    runWithSelfTestUntil([] { return false; }, 3000);
+    check(!selfTest.running() && status.operationMode == MODE_RAIN, "비 모드에서는 진단이 액추에이터를 잡지 않음");
+
+    // 서보 왕복 중 비 시작 → 제어가 바로 되찾고, 비가 그쳐 대기 모드로 돌아오면 진단 재시작
+    setInputs(400, 900, 700);
+    bootWithSelfTest();
+    runWithSelfTestUntil([] { return selfTest.running() && parasolMotion.target() == ANGLE_SHADE; }, 5000);
+    setInputs(400, 300, 700);
+    unsigned long yieldMs = runWithSelfTestUntil([] { return parasolMotion.target() == ANGLE_COLLECT; }, 1000);
+    check(yieldMs <= 5 && selfTestAborts == 1 && !selfTest.running(), "비 시작 시 진단 중단, 5ms 안에 수집 각도");
+    runWithSelfTestUntil([] { return false; }, 3000);
+    check(hal::native::servoAngle() == ANGLE_COLLECT && !selfTest.running(), "비 동안 수집 각도 유지");
+    setInputs(400, 900, 700);
+    runWithSelfTestUntil([] { return selfTest.done(); }, DWELL_RAIN_EXIT * 1000UL + 20000);
+    check(selfTest.done() && selfTest.record().runs == 2, "대기 모드 복귀 후 진단 완료");
+    runWithSelfTestUntil([] { return !selfTest.saving(); }, 1000);
+    unsigned long writes = hal::native::eepromWrites();
+    saveSelfTestRecord(selfTest.record());
+    check(hal::native::eepromWrites() == writes, "같은 기록을 다시 저장하면 EEPROM 쓰기 없음");
+
+    // 깨진 기록은 없는 것으로
+    hal::native::eepromData()[EEPROM_SELF_TEST_ADDR + 2] ^= 0x01;
+    bootWithSelfTest();
+    check(!selfTest.cached() && !status.systemReady, "CRC 불일치 기록은 무시");
+
+    // 실패 항목이 있던 기록은 캐시가 있어도 진단 후 제어
+    SelfTestRecord failed = { SELF_TEST_VERSION, SELFTEST_SERVO | SELFTEST_RELAY, 3, 6000 };
+    saveSelfTestRecord(failed);
+    bootWithSelfTest();
+    check(selfTest.cached() && !status.systemReady, "센서 실패 기록이면 진단 후 제어");
+}
+
+// EEPROM이 준비될 때마다 poll()만 돌려 대기열을 다 내보낸다
+void drainJournal() {
+    journal.flush();
+    while (journal.pending() > 0) {
+        hal::native::advanceMicros(100);
+        journal.poll();
+    }
+}
+
+// 슬롯 [0, head)는 lapBit, 나머지는 지운 상태(firstLap) 또는 반대 바퀴로 채운다
+void fillJournalSlots(uint16_t head, uint8_t lapBit, bool firstLap) {
+    hal::native::eraseEeprom();
+    uint8_t* eeprom = hal::native::eepromData();
+    for (uint16_t slot = 0; slot < JOURNAL_SLOTS; slot++) {
+        if (slot >= head && firstLap) continue;
+        JournalEntry e = { JOURNAL_MODE, (uint8_t)(slot % MODE_COUNT), 1, true };
+        Journal::encode(slot < head ? lapBit : lapBit ^ 1, e, eeprom + EEPROM_JOURNAL_ADDR + slot * JOURNAL_RECORD_BYTES);
+    }
+}
+
+void journalLog() {
+    printf("===== EEPROM 이벤트 기록 =====\n");
+
+    // 부팅 때 head 찾기: 첫 바퀴 / 여러 바퀴 / 바퀴가 딱 끝난 자리
+    bool recovered = true;
+    const uint16_t heads[] = { 0, 1, 2, 95, 96, 190, 191 };
+    for (uint16_t head : heads) {
+        for (uint8_t lapBit = 0; lapBit < 2; lapBit++) {
+            fillJournalSlots(head, lapBit, lapBit == 0);
+            journal.begin();
+            bool firstLap = lapBit == 0;
+            uint16_t stored = firstLap ? head : JOURNAL_SLOTS;
+            if (journal.headSlot() != head || journal.storedCount() != stored) {
+                printf("  head %u 바퀴 %u → head %u, %u건\n", head, lapBit, journal.headSlot(), journal.storedCount());
+                recovered = false;
+            }
+        }
+    }
+    fillJournalSlots(JOURNAL_SLOTS, 1, false);
+    journal.begin();
+    check(recovered && journal.headSlot() == 0 && journal.storedCount() == JOURNAL_SLOTS,
+          "이분 탐색으로 head 복구 (첫 바퀴, 여러 바퀴, 바퀴 끝)");
+
+    // 지운 칩에서 시작, 부팅 기록 + 모드/펌프 이벤트
+    hal::native::eraseEeprom();
+    boot();
+    check(journal.size() == 1 && journal.storedCount() == 0 && journal.pending() == 1, "부팅 기록은 대기열에");
+    setInputs(400, 900, 700);
+    runFor(DWELL_HEAT_ENTER * 1000UL + 1000);
+    setInputs(800, 900, 700);
+    runFor(5000);
+    setInputs(800, 300, 700);
+    runFor(2000);
+    check(journal.storedCount() >= JOURNAL_BATCH, "대기열이 차면 EEPROM으로 내보냄");
+
+    const uint8_t expectType[] = { JOURNAL_BOOT, JOURNAL_MODE, JOURNAL_PUMP_ON, JOURNAL_MODE, JOURNAL_PUMP_OFF };
+    const uint8_t expectArg[] = { 0, MODE_HEAT, 0, MODE_RAIN, 0 };
+    bool ordered = journal.size() == 5;
+    unsigned long seconds = 0;
+    for (uint16_t i = 0; ordered && i < 5; i++) {
+        JournalEntry e;
+        ordered = journal.entry(i, e) && e.intact && e.type == expectType[i] && e.arg == expectArg[i];
+        seconds += e.deltaSeconds;
+    }
+    check(ordered, "부팅 → 더위 → 펌프 ON → 비 → 펌프 OFF 순서");
+    printf("  마지막 기록: 부팅 후 %lu 초\n", seconds);
+    check(seconds >= DWELL_HEAT_ENTER + 6 && seconds <= DWELL_HEAT_ENTER + 8, "시간 차 누적 = 부팅 후 초");
+
+    // 한 건만 있어도 JOURNAL_FLUSH_MS가 지나면 내보냄
+    uint16_t stored = journal.storedCount();
+    setInputs(800, 900, 400);
+    runFor(DWELL_RAIN_EXIT * 1000UL + 1000);
+    uint8_t waiting = journal.pending();
+    runFor(JOURNAL_FLUSH_MS);
+    check(waiting > 0 && journal.pending() == 0 && journal.storedCount() == stored + waiting,
+          "오래된 기록은 시간이 지나면 내보냄");
+
+    // 내보내는 중에도 루프를 막지 않고 EEPROM이 준비됐을 때 한 바이트씩
+    for (uint8_t i = 0; i < JOURNAL_BATCH; i++) journal.record(JOURNAL_MODE, MODE_STANDBY);
+    unsigned long writes = hal::native::eepromWrites();
+    unsigned long before = hal::micros();
+    for (int i = 0; i < 10; i++) journal.poll();
+    check(hal::micros() == before && hal::native::eepromWrites() <= writes + 1, "쓰기 중에는 기다리지 않고 넘어감");
+    drainJournal();
+
+    // 리셋 후 head 복구, 대기열이 차 있으면 버린 건수 집계
+    uint16_t head = journal.headSlot();
+    boot();
+    check(journal.headSlot() == head && journal.storedCount() == head, "리셋 후 같은 자리에서 이어 씀");
+    for (uint8_t i = 0; i < JOURNAL_PENDING; i++) journal.record(JOURNAL_PUMP_ON);
+    check(journal.pending() == JOURNAL_PENDING && journal.stats().dropped == 1, "대기열이 차면 버리고 셈");
+    drainJournal();
+
+    // 슬롯 수보다 많이 쓰면 가장 오래된 기록부터 덮음. 모든 슬롯이 고르게 한 번씩
+    unsigned long wearBefore = hal::native::eepromWrites();
+    for (uint16_t i = 0; i < JOURNAL_SLOTS; i++) {
+        journal.record(JOURNAL_MODE, (uint8_t)(i % MODE_COUNT));
+        if (journal.pending() == JOURNAL_BATCH) drainJournal();
+    }
+    drainJournal();
+    unsigned long wear = hal::native::eepromWrites() - wearBefore;
+    printf("  %u건 기록: EEPROM %lu 바이트 쓰기 (슬롯당 최대 4)\n", JOURNAL_SLOTS, wear);
+    check(journal.storedCount() == JOURNAL_SLOTS && wear <= JOURNAL_SLOTS * 4UL, "한 바퀴 돌면 모든 슬롯 사용");
+    head = journal.headSlot();
+    boot();
+    check(journal.headSlot() == head && journal.storedCount() == JOURNAL_SLOTS, "바퀴를 넘긴 뒤 리셋해도 head 복구");
+
+    // 머리 바이트 전에 전원이 나가면 head는 그대로, 덮이던 예전 기록만 깨짐 표시
+    drainJournal();
+    head = journal.headSlot();
+    uint8_t* slot = hal::native::eepromData() + EEPROM_JOURNAL_ADDR + head * JOURNAL_RECORD_BYTES;
+    slot[1] ^= 0x5A;
+    slot[3] ^= 0x01;
+    journal.begin();
+    JournalEntry torn;
+    check(journal.headSlot() == head && journal.entry(0, torn) && !torn.intact, "쓰다 끊긴 슬롯은 head를 옮기지 않음");
+}
+
+void eraseCalibration() {
+    uint8_t* eeprom = hal::native::eepromData();
+    for (uint16_t i = 0; i < EEPROM_CALIBRATION_SIZE; i++) eeprom[EEPROM_CALIBRATION_ADDR + i] = 0xFF;
+}
+
+bool sameBounds(const ModeBounds& a, uint16_t rainBelow, uint16_t heatAbove, int16_t heatIndexAbove) {
+    return a.rainBelow == rainBelow && a.heatAbove == heatAbove && a.heatIndexAbove == heatIndexAbove;
+}
+
+void calibrationStore() {
+    printf("===== 현장 보정값 =====\n");
+    eraseCalibration();
+    boot();
+
+    // 기본값은 컴파일 타임 경계와 같은 원시값
+    check(!calibration.stored() && calibration.value(CAL_HEAT) == 280 && calibration.value(CAL_HEAT_HYSTERESIS) == 5,
+          "EEPROM에 없으면 기본값");
+    check(sameBounds(thresholds.mode[MODE_STANDBY], RAIN_THRESHOLD, HEAT_THRESHOLD_RAW, HEAT_INDEX_THRESHOLD_Q) &&
+          sameBounds(thresholds.mode[MODE_RAIN], RAIN_RELEASE, HEAT_THRESHOLD_RAW, HEAT_INDEX_THRESHOLD_Q) &&
+          sameBounds(thresholds.mode[MODE_HEAT], RAIN_THRESHOLD, HEAT_RELEASE_RAW, HEAT_INDEX_RELEASE_Q) &&
+          thresholds.waterOK == WATER_THRESHOLD, "기본 보정값 → 컴파일 타임과 같은 경계");
+    bool inverse = true;
+    for (int16_t tenths = 0; tenths <= 600; tenths += 5) {
+        float c = tenths / 10.0f;
+        int16_t q = (int16_t)(tenths * Q_ONE / 10);
+        if (tenths <= POT_TEMP_RANGE_C * 10 && potRawForQ(q) != potRawForCelsius(c)) inverse = false;
+        if (ky013RawForQ(q) != ky013RawForCelsius(c)) inverse = false;
+    }
+    check(inverse && potRawForQ(45 * Q_ONE) == ADC_MAX, "런타임 온도 경계 = 컴파일 타임 경계 (0.5°C 간격)");
+
+    uint8_t key = CAL_KEY_COUNT;
+    bool named = calibrationKeyFromName("water_full", key) && key == CAL_WATER_FULL;
+    named = named && calibrationKeyFromName("water", key) && key == CAL_WATER;
+    check(named && !calibrationKeyFromName("wat", key) && !calibrationKeyFromName("water_fullx", key),
+          "항목 이름 → 번호");
+
+    // 항목 범위, 항목 사이 관계는 commit 때. 실패하면 사용 중인 값은 그대로
+    check(calibration.set(CAL_RAIN, 2000) == CAL_OUT_OF_RANGE && calibration.edited(CAL_RAIN) == RAIN_THRESHOLD,
+          "범위 밖 값은 편집본에도 안 들어감");
+    calibration.set(CAL_WATER_EMPTY, 950);
+    check(calibration.commit() == CAL_WATER_ORDER && calibration.value(CAL_WATER_EMPTY) == WATER_EMPTY_VALUE &&
+          !calibration.saving(), "수위 빈 ≥ 가득이면 적용/저장 안 함");
+    calibration.revert();
+    calibration.set(CAL_RAIN, 1000);
+    calibration.set(CAL_RAIN_HYSTERESIS, 100);
+    check(calibration.commit() == CAL_RAIN_ORDER, "비 해제 경계가 ADC 범위 밖이면 거부");
+    calibration.revert();
+
+    // 적용은 즉시: 비 경계를 올리면 같은 입력이 비가 된다
+    setInputs(400, 580, 700);
+    runFor(DWELL_HEAT_ENTER * 1000UL + 1000);
+    check(status.operationMode == MODE_STANDBY, "빗물 580은 기본 경계(500)에서 비 아님");
+    calibration.set(CAL_RAIN, 600);
+    calibration.set(CAL_WATER_EMPTY, 200);
+    calibration.set(CAL_WATER_FULL, 800);
+    unsigned long writes = hal::native::eepromWrites();
+    check(calibration.commit() == CAL_OK && thresholds.mode[MODE_STANDBY].rainBelow == 600 &&
+          thresholds.mode[MODE_RAIN].rainBelow == 650, "commit → 경계 다시 계산");
+    check(hal::native::eepromWrites() == writes, "commit은 EEPROM을 기다리지 않음");
+    runFor(200);
+    check(status.operationMode == MODE_RAIN && calibration.stored() && !calibration.saving(),
+          "새 비 경계로 비 모드, 백그라운드 저장 끝");
+    check(sensors.waterLevelPercent.tenths() == 833, "새 수위 양 끝값으로 % (700 → 83.3%)");
+
+    // 리셋 후 EEPROM에서 같은 값, 순번 1
+    boot();
+    check(calibration.stored() && calibration.sequence() == 1 && calibration.value(CAL_RAIN) == 600 &&
+          thresholds.mode[MODE_STANDBY].rainBelow == 600, "리셋 후 저장된 보정값 사용");
+
+    // 저장 중 전원이 나가면 이전 슬롯 (CRC가 마지막이라 새 슬롯은 깨진 채)
+    calibration.set(CAL_HEAT, 300);
+    calibration.commit();
+    for (int i = 0; i < 10; i++) {
+        hal::native::advanceMicros(4000);
+        calibration.poll();
+    }
+    check(calibration.saving() && calibration.value(CAL_HEAT) == 300, "저장 도중에도 새 값으로 제어");
+    boot();
+    check(calibration.sequence() == 1 && calibration.value(CAL_HEAT) == 280 && calibration.value(CAL_RAIN) == 600,
+          "쓰다 끊긴 슬롯은 무시하고 이전 값");
+
+    // 두 슬롯을 번갈아: 두 번 더 저장하면 순번 3이 이긴다
+    calibration.set(CAL_HEAT, 300);
+    calibration.commit();
+    runFor(200);
+    calibration.set(CAL_HEAT, 310);
+    calibration.commit();
+    runFor(200);
+    boot();
+    check(calibration.sequence() == 3 && calibration.value(CAL_HEAT) == 310 &&
+          thresholds.mode[MODE_STANDBY].heatIndexAbove == 31 * Q_ONE, "새 순번 슬롯 선택");
+
+    calibration.loadDefaults();
+    check(calibration.commit() == CAL_OK && calibration.value(CAL_RAIN) == RAIN_THRESHOLD, "기본값으로 되돌림");
+    eraseCalibration();
+}
+
+// P² 분위수를 정렬한 정확한 분위수와 비교. 5% / 95%는 (n-1)·p 자리 (마커 위치와 같은 정의)
+bool nearExactQuantiles(const AutoCalQuantiles& q, std::vector<uint16_t> samples, uint16_t tolerance) {
+    std::sort(samples.begin(), samples.end());
+    size_t last = samples.size() - 1;
+    int low = samples[last * 5 / 100], high = samples[last * 95 / 100];
+    return abs(q.low() - low) <= tolerance && abs(q.high() - high) <= tolerance &&
+           q.minimum() == samples.front() && q.maximum() == samples.back();
+}
+
+void autoCalibrationSession() {
+    printf("===== 자동 보정 =====\n");
+    uint32_t seed = 12345;
+    auto next = [&seed]() { seed = seed * 1103515245UL + 12345; return (uint16_t)((seed >> 16) & 0x7FFF); };
+
+    AutoCalQuantiles uniform, bimodal;
+    std::vector<uint16_t> uniformSamples, bimodalSamples;
+    check(uniform.samples() == 0 && uniform.low() == 0 && !uniform.full(), "빈 추정기");
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 5000; i++) {
+        uint16_t u = 100 + next() % 801;
+        uniform.push(u);
+        uniformSamples.push_back(u);
+        // 마른 950 근처 70%, 젖은 250 근처 30%
+        uint16_t b = next() % 10 < 3 ? 230 + next() % 41 : 930 + next() % 41;
+        bimodal.push(b);
+        bimodalSamples.push_back(b);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    printf("  호스트 샘플당 %.0f ns (난수 포함), 추정기 %u 바이트\n", ns / 10000, (unsigned)sizeof(AutoCalQuantiles));
+    check(nearExactQuantiles(uniform, uniformSamples, 4), "P²: 균등 분포 5%/95% (정렬값과 ±4)");
+    check(nearExactQuantiles(bimodal, bimodalSamples, 4), "P²: 두 봉우리 분포 5%/95%");
+    check(sizeof(AutoCalQuantiles) <= 32, "P²: 채널당 32바이트 이하");
+
+    eraseCalibration();
+    boot();
+    autoCalibration.start();
+    AutoCalProposal proposal;
+    setInputs(400, 950, 500);
+    runFor(AUTOCAL_SAMPLE_MS * 20UL);
+    autoCalibration.propose(calibration, proposal);
+    check(proposal.waterResult == AUTOCAL_FEW_SAMPLES && proposal.rainResult == AUTOCAL_FEW_SAMPLES &&
+          AutoCalibration::loadProposal(proposal, calibration) == 0, "샘플이 적으면 제안 없음");
+
+    // 20분: 수위는 180 ↔ 820 삼각파(200초 주기), 빗물은 100초 중 30초만 젖음
+    autoCalibration.start();
+    for (unsigned s = 0; s < 1200; s++) {
+        unsigned phase = s % 200;
+        uint16_t water = (uint16_t)(phase < 100 ? 180 + phase * 64 / 10 : 820 - (phase - 100) * 64 / 10);
+        setInputs(400, s % 100 < 30 ? 250 : 950, water);
+        runFor(1000);
+    }
+    const AutoCalQuantiles& w = autoCalibration.quantiles(AUTOCAL_WATER);
+    const AutoCalQuantiles& r = autoCalibration.quantiles(AUTOCAL_RAIN);
+    printf("  수위 %u 샘플: 하위 %d 상위 %d / 빗물: 하위 %d 상위 %d\n", w.samples(), w.low(), w.high(), r.low(), r.high());
+    check(w.samples() == 1200000UL / AUTOCAL_SAMPLE_MS, "2초마다 한 샘플");
+    autoCalibration.propose(calibration, proposal);
+    check(proposal.waterResult == AUTOCAL_OK && abs(proposal.waterEmpty - 212) <= 12 &&
+          abs(proposal.waterFull - 788) <= 12, "수위 양 끝값 제안 = 5%/95% 분위수 (212/788 근처)");
+    check(proposal.water == proposal.waterEmpty + 500 * (proposal.waterFull - proposal.waterEmpty) / 800,
+          "펌프 가능 수위는 예전 양 끝값 사이 비율 (600 → 62.5%) 유지");
+    check(proposal.rainResult == AUTOCAL_OK && abs(proposal.rain - 600) <= 10, "비 경계 = 젖음/마름 가운데");
+
+    unsigned long writes = hal::native::eepromWrites();
+    check(AutoCalibration::loadProposal(proposal, calibration) == 2 &&
+          calibration.value(CAL_WATER_EMPTY) == WATER_EMPTY_VALUE && hal::native::eepromWrites() == writes,
+          "제안은 편집본에만");
+    check(calibration.commit() == CAL_OK && thresholds.waterOK == (uint16_t)proposal.water &&
+          thresholds.mode[MODE_STANDBY].rainBelow == proposal.rain, "c save로 적용");
+    setInputs(400, 950, (uint16_t)proposal.waterFull);
+    runFor(2000);
+    check(sensors.waterLevelPercent.tenths() == 1000, "새 가득 값에서 100%");
+
+    // 중지하면 더 모으지 않고, 변화 폭이 좁으면 (비가 안 온 세션) 그 채널만 제안 없음
+    autoCalibration.stop();
+    uint16_t samples = w.samples();
+    runFor(AUTOCAL_SAMPLE_MS * 5UL);
+    check(!autoCalibration.running() && w.samples() == samples, "중지 후 샘플 안 늘어남");
+    autoCalibration.start();
+    for (unsigned s = 0; s < 400; s++) {
+        setInputs(400, 940 + s % 20, 300 + (s % 100) * 5);
+        runFor(1000);
+    }
+    autoCalibration.propose(calibration, proposal);
+    check(proposal.rainResult == AUTOCAL_NARROW && proposal.waterResult == AUTOCAL_OK, "비 안 온 세션은 빗물만 제안 없음");
+    autoCalibration.stop();
+    eraseCalibration();
+}
+
+void benchmark() {
+    const unsigned long ITERATIONS = 20000000UL;
+    printf("===== 성능 =====\n");
+    boot();
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i < ITERATIONS; i++) {
+        // 약 65초 주기로 비/더위/수위가 바뀌는 입력 패턴
+        unsigned long phase = (i >> 16) & 3;
+        setInputs(phase & 1 ? 800 : 400, phase == 2 ? 300 : 900, phase == 3 ? 400 : 700);
+        hal::native::advance(1);
+        controlTick();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("  반복: %lu 회 (가상 시간 %lu 초)\n", ITERATIONS, ITERATIONS / 1000);
+    printf("  소요: %.3f 초, %.1f 백만 회/초\n", seconds, ITERATIONS / seconds / 1e6);
+    printf("  모드 전환: %d 회, 서보 쓰기: %lu 회\n", modeChanges, hal::native::servoWrites());
+    const char* names[ACT_COUNT] = { "릴레이", "파라솔", "서보" };
+    for (uint8_t i = 0; i < ACT_COUNT; i++) {
+        const CommandStats& st = actuators.stats((ActuatorId)i);
+        printf("  %s 명령: 적용 %lu / 생략 %lu\n", names[i], st.applied, st.suppressed);
+    }
+}
+
+}
+
+int main() {
+    scenarios();
+    board();
+    servoPulse();
+    ky013();
+    dhtSensor();
+    telemetry();
+    logger();
+    filters();
+    registry();
+    messages();
+    profiler();
+    rainOnset();
+    selfTestBoot();
+    journalLog();
+    calibrationStore();
+    autoCalibrationSession();
+    benchmark();
+
+    if (failures) {
+        printf("실패: %d 건\n", failures);
+        return 1;
+    }
+    printf("모든 시나리오 통과\n");
+    return 0;
+}
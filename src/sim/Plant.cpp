@@ -0,0 +1,123 @@
+#include "Plant.h"
+
+#include <cmath>
+#include <ControlCore.h>
+
+namespace {
+
+const double MS_PER_HOUR = 3600.0 * 1000.0;
+const double MS_PER_DAY = 24.0 * MS_PER_HOUR;
+const double PI = 3.14159265358979323846;
+
+// 빗물 센서: 마른 상태 950, 강우 강도(mm/h)에 비례해 내려감 (낮을수록 젖음)
+const double RAIN_DRY_RAW = 950.0;
+const double RAIN_RAW_PER_MMH = 120.0;
+
+}
+
+Plant::Plant(const PlantConfig& config, unsigned seed)
+    : collectedL(0), pumpedL(0), overflowL(0), pumpDryMs(0),
+      config(config), rng(seed), nowMs(0), tank(config.initialTankL),
+      temperature(config.dailyMeanC), rainMmH(0), currentDay(-1), dayMeanC(config.dailyMeanC) {
+}
+
+double Plant::collectionEfficiency(uint8_t servoAngle) {
+    // 130도 빗물 수집 각도에서 가장 잘 모이고, 차양/수납 각도에서는 거의 안 모임
+    if (servoAngle >= ANGLE_COLLECT - 10) return 0.8;
+    if (servoAngle >= ANGLE_SHADE - 10) return 0.3;
+    return 0.05;
+}
+
+double Plant::netFlowLps(uint8_t servoAngle, bool pumpOn) const {
+    // 1mm 비가 1m²에 내리면 1L
+    double inflow = rainMmH * config.canopyAreaM2 * collectionEfficiency(servoAngle) / 3600.0;
+    double outflow = pumpOn ? config.pumpLitersPerMin / 60.0 : 0.0;
+    return inflow - outflow;
+}
+
+void Plant::advanceTo(double timeMs, uint8_t servoAngle, bool pumpOn) {
+    double dtMs = timeMs - nowMs;
+    if (dtMs <= 0) return;
+    nowMs = timeMs;
+
+    double dtS = dtMs / 1000.0;
+    double inflow = rainMmH * config.canopyAreaM2 * collectionEfficiency(servoAngle) / 3600.0 * dtS;
+    double demand = pumpOn ? config.pumpLitersPerMin / 60.0 * dtS : 0.0;
+    collectedL += inflow;
+
+    tank += inflow;
+    double pumped = demand < tank ? demand : tank;
+    tank -= pumped;
+    pumpedL += pumped;
+    if (pumpOn && demand > pumped) {
+        pumpDryMs += dtMs * (demand - pumped) / demand;
+    }
+    if (tank > config.tankCapacityL) {
+        overflowL += tank - config.tankCapacityL;
+        tank = config.tankCapacityL;
+    }
+}
+
+void Plant::updateTemperature(double timeMs) {
+    int day = (int)(timeMs / MS_PER_DAY);
+    if (day != currentDay) {
+        currentDay = day;
+        std::uniform_real_distribution<double> spread(-config.dailyMeanSpreadC, config.dailyMeanSpreadC);
+        dayMeanC = config.dailyMeanC + spread(rng);
+    }
+
+    // 오전 9시에 평균, 오후 3시에 최고
+    double hour = std::fmod(timeMs, MS_PER_DAY) / MS_PER_HOUR;
+    temperature = dayMeanC + config.dailySwingC * std::sin(2.0 * PI * (hour - 9.0) / 24.0);
+    if (raining()) temperature -= config.rainCoolingC;
+}
+
+void Plant::startRain() {
+    std::uniform_real_distribution<double> intensity(config.rainMinMmH, config.rainMaxMmH);
+    rainMmH = intensity(rng);
+}
+
+void Plant::stopRain() {
+    rainMmH = 0;
+}
+
+double Plant::drawRainGapMs() {
+    std::exponential_distribution<double> gap(1.0 / config.rainEveryHours);
+    return gap(rng) * MS_PER_HOUR;
+}
+
+double Plant::drawRainDurationMs() {
+    std::exponential_distribution<double> duration(1.0 / config.rainHours);
+    return (0.1 + duration(rng)) * MS_PER_HOUR;
+}
+
+double Plant::msUntilWaterRawChange(uint8_t servoAngle, bool pumpOn) const {
+    double flow = netFlowLps(servoAngle, pumpOn);
+    if (flow == 0) return -1;
+    if (flow < 0 && tank <= 0) return -1;
+    if (flow > 0 && tank >= config.tankCapacityL) return -1;
+
+    double litersPerLsb = config.tankCapacityL / (WATER_FULL_VALUE - WATER_EMPTY_VALUE);
+    double position = tank / litersPerLsb;
+    double boundary = flow > 0 ? std::floor(position) + 1.0 : std::ceil(position) - 1.0;
+    double seconds = std::fabs((boundary - position) * litersPerLsb / flow);
+    return seconds * 1000.0 + 1.0;
+}
+
+uint16_t Plant::temperatureRaw() const {
+    double raw = temperature * ADC_MAX / POT_TEMP_RANGE_C;
+    if (raw < 0) raw = 0;
+    if (raw > ADC_MAX) raw = ADC_MAX;
+    return (uint16_t)raw;
+}
+
+uint16_t Plant::rainRaw() const {
+    double raw = RAIN_DRY_RAW - RAIN_RAW_PER_MMH * rainMmH;
+    if (raw < 100) raw = 100;
+    return (uint16_t)raw;
+}
+
+uint16_t Plant::waterRaw() const {
+    double span = WATER_FULL_VALUE - WATER_EMPTY_VALUE;
+    return (uint16_t)(WATER_EMPTY_VALUE + std::floor(tank / config.tankCapacityL * span + 1e-9));
+}
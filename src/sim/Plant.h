@@ -0,0 +1,80 @@
+/*
+ * SmartCool Parasol - 시뮬레이션용 플랜트(날씨/물탱크/펌프) 모델
+ *
+ * 날씨: 일별 평균기온 + 일교차 사인 곡선, 포아송 도착 강우 에피소드
+ * 물탱크: 파라솔 각도에 따른 빗물 수집량 유입, 펌프 가동 시 유출
+ * 센서: 기존 하드웨어와 같은 ADC 원시값 범위로 변환 (ControlCore 상수 사용)
+ */
+
+#ifndef SMARTCOOL_SIM_PLANT_H
+#define SMARTCOOL_SIM_PLANT_H
+
+#include <stdint.h>
+#include <random>
+
+struct PlantConfig {
+    double tankCapacityL = 10.0;      // 물탱크 용량
+    double initialTankL = 5.0;
+    double canopyAreaM2 = 2.0;        // 파라솔 빗물 수집 면적
+    double pumpLitersPerMin = 0.5;    // 미스트 펌프 유량
+
+    double dailyMeanC = 27.0;         // 일 평균기온 (날마다 ±dailyMeanSpreadC)
+    double dailyMeanSpreadC = 3.0;
+    double dailySwingC = 5.0;         // 일교차 진폭
+    double rainCoolingC = 3.0;        // 비 올 때 기온 하강
+
+    double rainEveryHours = 40.0;     // 강우 에피소드 평균 간격
+    double rainHours = 3.0;           // 평균 지속 시간
+    double rainMinMmH = 1.0;          // 강우 강도 범위
+    double rainMaxMmH = 15.0;
+};
+
+class Plant {
+public:
+    Plant(const PlantConfig& config, unsigned seed);
+
+    // 현재 액추에이터 상태로 timeMs까지 물탱크 적분
+    void advanceTo(double timeMs, uint8_t servoAngle, bool pumpOn);
+
+    // 날씨 갱신 (이벤트 처리용)
+    void updateTemperature(double timeMs);
+    void startRain();
+    void stopRain();
+
+    // 다음 강우 에피소드까지/강우 지속 시간 (ms)
+    double drawRainGapMs();
+    double drawRainDurationMs();
+
+    // 수위 센서 원시값이 1 LSB 바뀌는 데 걸리는 시간 (ms), 변화 없으면 음수
+    double msUntilWaterRawChange(uint8_t servoAngle, bool pumpOn) const;
+
+    uint16_t temperatureRaw() const;
+    uint16_t rainRaw() const;
+    uint16_t waterRaw() const;
+
+    bool raining() const { return rainMmH > 0; }
+    double temperatureC() const { return temperature; }
+    double tankLiters() const { return tank; }
+
+    // 누적 통계
+    double collectedL;
+    double pumpedL;
+    double overflowL;
+    double pumpDryMs;
+
+private:
+    double netFlowLps(uint8_t servoAngle, bool pumpOn) const;
+    static double collectionEfficiency(uint8_t servoAngle);
+
+    PlantConfig config;
+    std::mt19937 rng;
+
+    double nowMs;
+    double tank;
+    double temperature;
+    double rainMmH;
+    int currentDay;
+    double dayMeanC;
+};
+
+#endif
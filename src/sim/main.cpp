@@ -0,0 +1,318 @@
+/*
+ * SmartCool Parasol - 이산 사건(discrete-event) 플랜트 시뮬레이터
+ *
+ * 실행: pio run -e sim && .pio/build/sim/program [일수=92] [시드=1]
+ *
+ * 날씨/물탱크 이벤트를 시간순 큐로 처리하고, 센서 입력이 바뀐 직후
+ * SETTLE_MS 동안만 ControlCore 태스크를 실제 주기대로 돌린다.
+ * 입력이 그대로인 구간에서는 제어 출력도 바뀌지 않으므로 가상 시계를 건너뛴다.
+ * 여름 한 철(92일)을 몇 초 안에 돌려 임계값 튜닝 결과를 비교할 수 있다.
+ */
+
+#include <chrono>
+#include <queue>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include <ControlCore.h>
+#include <HalNative.h>
+
+#include "Plant.h"
+
+namespace {
+
+const unsigned long SETTLE_MS = 300;            // 입력 변화 후 제어 루프를 돌릴 시간
+const unsigned long TEMPERATURE_STEP_MS = 60000;
+const double MS_PER_HOUR = 3600.0 * 1000.0;
+
+enum EventType {
+    EVENT_TEMPERATURE,
+    EVENT_RAIN_START,
+    EVENT_RAIN_END,
+    EVENT_TANK_LSB,
+    EVENT_END
+};
+
+struct Event {
+    unsigned long time;
+    EventType type;
+    unsigned version;   // 물탱크 이벤트 무효화용
+
+    bool operator>(const Event& other) const { return time > other.time; }
+};
+
+struct LatencyStats {
+    unsigned long count = 0;
+    unsigned long min = 0;
+    unsigned long max = 0;
+    unsigned long long sum = 0;
+
+    void add(unsigned long ms) {
+        if (count == 0 || ms < min) min = ms;
+        if (ms > max) max = ms;
+        sum += ms;
+        count++;
+    }
+};
+
+std::priority_queue<Event, std::vector<Event>, std::greater<Event> > events;
+Plant* plant = 0;
+
+unsigned long activeUntil = 0;
+bool quiescent = true;
+unsigned tankVersion = 0;
+unsigned long long controlRuns = 0;
+unsigned long long eventCount = 0;
+
+// 액추에이터/모드 상태 추적
+uint8_t lastServo = 0;
+bool lastPump = false;
+int lastMode = MODE_STANDBY;
+unsigned long modeSince = 0;
+unsigned long modeMs[3] = { 0, 0, 0 };
+unsigned long modeChanges = 0;
+unsigned long pumpSince = 0;
+unsigned long pumpOnMs = 0;
+unsigned long pumpStarts = 0;
+unsigned long lowWaterStops = 0;
+
+// 감지 → 구동 지연
+bool rainPending = false;
+bool heatPending = false;
+unsigned long rainOnset = 0;
+unsigned long heatOnset = 0;
+LatencyStats rainLatency;
+LatencyStats heatLatency;
+
+uint16_t lastTempRaw = 0;
+uint16_t lastRainRaw = 0;
+uint16_t lastWaterRaw = 0;
+
+unsigned long now() { return hal::millis(); }
+
+void setClock(unsigned long ms) {
+    if (ms > now()) hal::native::advance(ms - now());
+}
+
+bool pumpOn() { return hal::native::pinLevel(RELAY_PIN) == HIGH; }
+
+void onModeChanged(int mode) {
+    modeMs[lastMode] += now() - modeSince;
+    modeSince = now();
+    lastMode = mode;
+    modeChanges++;
+}
+
+void onPumpEvent(PumpEvent event) {
+    if (event == PUMP_STOPPED_LOW_WATER) lowWaterStops++;
+}
+
+const ControlHooks hooks = { onModeChanged, onPumpEvent, 0 };
+
+void scheduleTankEvent() {
+    tankVersion++;
+    double ms = plant->msUntilWaterRawChange(hal::native::servoAngle(), pumpOn());
+    if (ms < 0) return;
+    Event e = { now() + (unsigned long)ms, EVENT_TANK_LSB, tankVersion };
+    events.push(e);
+}
+
+// 액추에이터 출력 변화 반영: 통계, 지연 측정, 물탱크 이벤트 재계산
+void observeOutputs() {
+    // 지연은 감지 → 목표 각도 명령까지 (램프 이동 시간 제외)
+    if (rainPending && parasolMotion.target() == ANGLE_COLLECT) {
+        rainLatency.add(now() - rainOnset);
+        rainPending = false;
+    }
+    if (heatPending && parasolMotion.target() == ANGLE_SHADE) {
+        heatLatency.add(now() - heatOnset);
+        heatPending = false;
+    }
+
+    uint8_t servo = hal::native::servoAngle();
+    bool pump = pumpOn();
+    if (servo == lastServo && pump == lastPump) return;
+
+    if (pump && !lastPump) {
+        pumpSince = now();
+        pumpStarts++;
+    } else if (!pump && lastPump) {
+        pumpOnMs += now() - pumpSince;
+    }
+
+    lastServo = servo;
+    lastPump = pump;
+    scheduleTankEvent();
+}
+
+// 플랜트 상태를 ADC 입력에 반영. 바뀌었으면 제어 루프를 깨운다
+void refreshInputs() {
+    uint16_t tempRaw = plant->temperatureRaw();
+    uint16_t rainRaw = plant->rainRaw();
+    uint16_t waterRaw = plant->waterRaw();
+    if (tempRaw == lastTempRaw && rainRaw == lastRainRaw && waterRaw == lastWaterRaw) return;
+
+    if (rainRaw < RAIN_THRESHOLD && lastRainRaw >= RAIN_THRESHOLD) {
+        rainPending = true;
+        rainOnset = now();
+    }
+    if (tempRaw > HEAT_THRESHOLD_RAW && lastTempRaw <= HEAT_THRESHOLD_RAW && rainRaw >= RAIN_THRESHOLD) {
+        heatPending = true;
+        heatOnset = now();
+    }
+
+    hal::native::setAnalog(TEMPERATURE_PIN, tempRaw);
+    hal::native::setAnalog(RAIN_SENSOR_PIN, rainRaw);
+    hal::native::setAnalog(WATER_LEVEL_PIN, waterRaw);
+    lastTempRaw = tempRaw;
+    lastRainRaw = rainRaw;
+    lastWaterRaw = waterRaw;
+
+    if (quiescent) {
+        scheduler.resync();
+        quiescent = false;
+    }
+    activeUntil = now() + SETTLE_MS;
+}
+
+void advancePlant(unsigned long ms) {
+    plant->advanceTo(ms, hal::native::servoAngle(), pumpOn());
+    setClock(ms);
+}
+
+// 제어 루프가 깨어 있는 동안 태스크 릴리즈 시각마다 실행
+void runControlUntil(unsigned long limit) {
+    while (!quiescent) {
+        unsigned long next = scheduler.nextReleaseTime();
+        // 파라솔이 램프 이동 중이거나 모드 전이가 유지 시간을 기다리는 중이면
+        // 입력이 그대로여도 계속 돌린다
+        if (next > activeUntil && !parasolMotion.moving() && !modeTransitionPending()) {
+            quiescent = true;
+            break;
+        }
+        if (next > limit) break;
+
+        advancePlant(next);
+        while (controlTick()) controlRuns++;
+        observeOutputs();
+    }
+}
+
+void handle(const Event& e) {
+    switch (e.type) {
+    case EVENT_TEMPERATURE: {
+        plant->updateTemperature(e.time);
+        Event next = { e.time + TEMPERATURE_STEP_MS, EVENT_TEMPERATURE, 0 };
+        events.push(next);
+        break;
+    }
+    case EVENT_RAIN_START: {
+        plant->startRain();
+        plant->updateTemperature(e.time);
+        Event end = { e.time + (unsigned long)plant->drawRainDurationMs(), EVENT_RAIN_END, 0 };
+        events.push(end);
+        scheduleTankEvent();
+        break;
+    }
+    case EVENT_RAIN_END: {
+        plant->stopRain();
+        plant->updateTemperature(e.time);
+        Event start = { e.time + (unsigned long)plant->drawRainGapMs(), EVENT_RAIN_START, 0 };
+        events.push(start);
+        scheduleTankEvent();
+        break;
+    }
+    case EVENT_TANK_LSB:
+        if (e.version == tankVersion) scheduleTankEvent();
+        break;
+    case EVENT_END:
+        break;
+    }
+}
+
+void boot(unsigned long endMs) {
+    hal::native::reset();
+    initializeSystem();
+    initializePins();
+    initializeActuators();
+    status.systemReady = true;
+    controlBegin(hooks);
+    lastServo = hal::native::servoAngle();
+
+    Event first[] = {
+        { 0, EVENT_TEMPERATURE, 0 },
+        { (unsigned long)plant->drawRainGapMs(), EVENT_RAIN_START, 0 },
+        { endMs, EVENT_END, 0 },
+    };
+    for (const Event& e : first) events.push(e);
+}
+
+double hours(unsigned long ms) { return ms / MS_PER_HOUR; }
+
+void printLatency(const char* name, const LatencyStats& s) {
+    if (s.count == 0) {
+        printf("  %s: 측정 없음\n", name);
+        return;
+    }
+    printf("  %s: %lu 회, 최소 %lu / 평균 %.1f / 최대 %lu ms\n",
+           name, s.count, s.min, (double)s.sum / s.count, s.max);
+}
+
+}
+
+int main(int argc, char** argv) {
+    unsigned long days = argc > 1 ? strtoul(argv[1], 0, 10) : 92;
+    unsigned seed = argc > 2 ? (unsigned)strtoul(argv[2], 0, 10) : 1;
+    unsigned long endMs = days * 24UL * 3600UL * 1000UL;
+
+    PlantConfig config;
+    Plant model(config, seed);
+    plant = &model;
+
+    auto start = std::chrono::steady_clock::now();
+    boot(endMs);
+
+    while (!events.empty()) {
+        Event e = events.top();
+        events.pop();
+        eventCount++;
+
+        runControlUntil(e.time);
+        advancePlant(e.time);
+        if (e.type == EVENT_END) break;
+
+        handle(e);
+        refreshInputs();
+        runControlUntil(e.time);
+    }
+
+    // 진행 중인 구간 마감
+    modeMs[lastMode] += now() - modeSince;
+    if (lastPump) pumpOnMs += now() - pumpSince;
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("===== 시뮬레이션 결과 (%lu일, 시드 %u) =====\n", days, seed);
+    printf("  실행 시간: %.2f 초 (이벤트 %llu 개, 제어 태스크 %llu 회)\n", seconds, eventCount, controlRuns);
+    printf("  임계값: 더위 > %d raw (해제 %d), 비 < %d (해제 %d), 수위 >= %d\n",
+           HEAT_THRESHOLD_RAW, HEAT_RELEASE_RAW, RAIN_THRESHOLD, RAIN_RELEASE, WATER_THRESHOLD);
+    printf("\n[모드별 시간]\n");
+    const char* names[3] = { "대기", "비", "더위" };
+    for (int i = 0; i < 3; i++) {
+        printf("  %-6s %8.1f 시간 (%5.1f%%)\n", names[i], hours(modeMs[i]), 100.0 * modeMs[i] / endMs);
+    }
+    printf("  모드 전환: %lu 회\n", modeChanges);
+
+    printf("\n[펌프/물]\n");
+    printf("  펌프 가동: %.1f 시간, 듀티 %.2f%% (더위 모드 대비 %.1f%%), 시동 %lu 회\n",
+           hours(pumpOnMs), 100.0 * pumpOnMs / endMs,
+           modeMs[MODE_HEAT] ? 100.0 * pumpOnMs / modeMs[MODE_HEAT] : 0.0, pumpStarts);
+    printf("  수위 부족 정지: %lu 회, 공회전 %.1f 분\n", lowWaterStops, model.pumpDryMs / 60000.0);
+    printf("  사용한 물: %.1f L, 수집한 빗물: %.1f L, 넘친 물: %.1f L, 남은 물: %.1f L\n",
+           model.pumpedL, model.collectedL, model.overflowL, model.tankLiters());
+
+    printf("\n[감지 → 구동 지연]\n");
+    printLatency("비 → 빗물 수집 각도", rainLatency);
+    printLatency("더위 → 차양 각도", heatLatency);
+    return 0;
+}
@@ -0,0 +1,126 @@
+/*
+ * SmartCool Parasol - 바이너리 텔레메트리 디코더 (호스트)
+ *
+ * 실행: pio run -e telemetry && .pio/build/telemetry/program [캡처파일]
+ * 예:   stty -F /dev/ttyACM0 9600 raw && .pio/build/telemetry/program /dev/ttyACM0
+ *
+ * 파일(없으면 표준 입력)에서 바이트를 읽어 프레임마다 CSV 한 줄을 출력하고,
+ * 끝나면 정상/CRC 오류/프레임 오류/유실 개수를 표준 오류로 출력한다.
+ *
+ * 카탈로그 메시지 프레임(-DLOG_CATALOG=1 빌드)은 Messages.h 표로 문장을 펼치고,
+ * 부팅 메시지 같은 텍스트 줄과 함께 '# '을 붙여 CSV 사이에 그대로 출력한다.
+ * 펌웨어와 같은 커밋의 Messages.h로 빌드해야 번호가 맞는다.
+ */
+
+#include <stdio.h>
+#include <string>
+
+#include <MessageLog.h>
+#include <Telemetry.h>
+
+namespace {
+
+const char* const MODE_NAMES[] = { "standby", "rain", "heat" };
+
+void printHeader() {
+    printf("seq,type,uptime_ms,temp_c,temp_raw,rain,water_raw,water_pct,"
+           "mode,parasol,pump,rain_detected,heat_detected,water_ok,valid,"
+           "humidity_pct,heat_index_c,humidity_valid\n");
+}
+
+void printRecord(const TelemetryRecord& r) {
+    const char* mode = r.operationMode < 3 ? MODE_NAMES[r.operationMode] : "?";
+    printf("%u,%s,%lu,%.2f,%u,%u,%u,%.1f,%s,%d,%d,%d,%d,%d,%d,%.1f,%.2f,%d\n",
+           r.sequence,
+           r.type == TELEMETRY_EVENT ? "event" : "status",
+           (unsigned long)r.uptimeMs,
+           r.temperatureQ / 256.0,
+           r.temperatureRaw, r.rainLevel, r.waterLevelRaw,
+           r.waterPercentQ / 256.0,
+           mode,
+           (r.flags & TFLAG_PARASOL_DEPLOYED) != 0,
+           (r.flags & TFLAG_PUMP_ACTIVE) != 0,
+           (r.flags & TFLAG_RAIN_DETECTED) != 0,
+           (r.flags & TFLAG_HEAT_DETECTED) != 0,
+           (r.flags & TFLAG_WATER_OK) != 0,
+           (r.flags & TFLAG_SENSORS_VALID) != 0,
+           r.humidityQ / 256.0,
+           r.heatIndexQ / 256.0,
+           (r.flags & TFLAG_HUMIDITY_VALID) != 0);
+    fflush(stdout);
+}
+
+void printText(const uint8_t* data, size_t length) {
+    std::string text((const char*)data, length);
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) end = text.size();
+        std::string line = text.substr(start, end - start);
+        if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+        printf("# %s\n", line.c_str());
+        start = end + 1;
+    }
+    fflush(stdout);
+}
+
+bool printMessage(const uint8_t* block, size_t length) {
+    uint8_t raw[MESSAGE_FRAME_MAX];
+    if (length > sizeof(raw)) return false;
+    size_t rawLength = cobsDecode(block, length, raw);
+
+    MessageRecord message;
+    if (!decodeMessagePayload(raw, rawLength, message)) return false;
+
+    const char* text = messageCatalogText(message.id);
+    if (!text) {
+        printf("# ? 메시지 %u\n", message.id);
+    } else {
+        LogLine line;
+        messageExpand(line, text, message.args, message.count);
+        printf("# %.*s\n", (int)line.size(), line.data());
+    }
+    fflush(stdout);
+    return true;
+}
+
+}
+
+int main(int argc, char** argv) {
+    FILE* in = stdin;
+    if (argc > 1) {
+        in = fopen(argv[1], "rb");
+        if (!in) {
+            perror(argv[1]);
+            return 1;
+        }
+    }
+
+    TelemetryDecoder decoder;
+    printHeader();
+
+    // 구분자 0x00 사이의 덩어리: 메시지 프레임 → 텍스트 → 텔레메트리 프레임 순으로 본다.
+    // 텍스트만 오는 동안에는 구분자가 없으므로 줄마다 내보낸다 (LogStreamSplitter)
+    LogStreamSplitter splitter;
+    int c;
+    while ((c = fgetc(in)) != EOF) {
+        LogStreamSplitter::Chunk chunk = splitter.feed((uint8_t)c);
+        if (chunk == LogStreamSplitter::CHUNK_TEXT) {
+            printText(splitter.data(), splitter.size());
+        } else if (chunk == LogStreamSplitter::CHUNK_BLOCK && !printMessage(splitter.data(), splitter.size())) {
+            if (looksLikeLogText(splitter.data(), splitter.size())) {
+                printText(splitter.data(), splitter.size());
+            } else if (decoder.decode(splitter.data(), splitter.size())) {
+                printRecord(decoder.record());
+            }
+        }
+    }
+    if (splitter.finish() == LogStreamSplitter::CHUNK_TEXT) printText(splitter.data(), splitter.size());
+
+    const TelemetryDecoder::Counters& st = decoder.counters();
+    fprintf(stderr, "프레임 %lu, CRC 오류 %lu, 프레임 오류 %lu, 버전 불일치 %lu, 유실 %lu\n",
+            st.frames, st.crcErrors, st.framingErrors, st.versionErrors, st.lostFrames);
+
+    if (in != stdin) fclose(in);
+    return 0;
+}
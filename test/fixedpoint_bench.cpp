@@ -0,0 +1,94 @@
+/*
+ * 고정소수점 vs float 센서 변환 사이클 비교
+ * SmartCool Parasol 프로젝트 - 독립 벤치마크 파일
+ *
+ * 사용법:
+ * 1. main.cpp 대신 이 파일을 업로드
+ * 2. 시리얼 모니터(9600)에서 변환 1회당 평균 CPU 사이클 확인
+ *
+ * Timer1을 분주 없이(16MHz) 돌려 TCNT1 차이로 사이클을 잰다.
+ * 측정 오버헤드(빈 루프)는 따로 재서 빼고 출력한다.
+ */
+
+#include <Arduino.h>
+#include <SensorConversion.h>
+
+const uint16_t STEP = 7;            // 0~1023을 고르게 훑는 간격
+volatile uint16_t sinkQ;
+volatile float sinkF;
+
+// 기존 코드의 float 변환 (비교용)
+float potFloat(int raw) { return (raw / 1023.0) * 40.0; }
+// KY-013 NTC를 Steinhart-Hart로 매번 계산 (log 소프트 float)
+float ky013Float(int raw) {
+    if (raw < 1) raw = 1;
+    if (raw > 1022) raw = 1022;
+    float ln = log(KY013_SERIES_OHMS * (1023.0 / raw - 1.0));
+    return 1.0 / (KY013_SH_A + KY013_SH_B * ln + KY013_SH_C * ln * ln * ln) - 273.15;
+}
+float waterFloat(int raw) {
+    if (raw <= 100) return 0.0;
+    if (raw >= 900) return 100.0;
+    return ((raw - 100) / 800.0) * 100.0;
+}
+
+const LinearScale WATER_SCALE = makeLinearScale(100, 900, 100 * Q_ONE);
+
+uint16_t samples = 0;
+
+// 변환 1회 사이클 측정 (TCNT1 오버플로 전 구간만 사용)
+#define MEASURE(total, expr)                        \
+    do {                                            \
+        total = 0;                                  \
+        samples = 0;                                \
+        for (uint16_t raw = 0; raw <= 1023; raw += STEP) { \
+            volatile uint16_t in = raw;             \
+            noInterrupts();                         \
+            uint16_t t0 = TCNT1;                    \
+            expr;                                   \
+            uint16_t t1 = TCNT1;                    \
+            interrupts();                           \
+            total += (uint16_t)(t1 - t0);           \
+            samples++;                              \
+        }                                           \
+    } while (0)
+
+void report(const __FlashStringHelper* name, unsigned long total, unsigned long overhead) {
+    Serial.print(name);
+    Serial.print(F(": "));
+    Serial.print((total - overhead) / samples);
+    Serial.println(F(" cycles"));
+}
+
+void setup() {
+    Serial.begin(9600);
+    delay(2000);
+
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);     // 분주 1
+
+    unsigned long overhead, t;
+    MEASURE(overhead, (void)in);
+
+    Serial.println(F("===== 센서 변환 사이클 비교 ====="));
+
+    MEASURE(t, sinkF = potFloat(in));
+    report(F("포텐셔미터 float"), t, overhead);
+    MEASURE(t, sinkQ = potentiometerToCelsius(in).q);
+    report(F("포텐셔미터 Q8.8 "), t, overhead);
+
+    MEASURE(t, sinkF = ky013Float(in));
+    report(F("KY-013 S-H float"), t, overhead);
+    MEASURE(t, sinkQ = ky013ToCelsius(in).q);
+    report(F("KY-013 표 보간  "), t, overhead);
+
+    MEASURE(t, sinkF = waterFloat(in));
+    report(F("수위 float      "), t, overhead);
+    MEASURE(t, sinkQ = waterLevelToPercent(in, WATER_SCALE).q);
+    report(F("수위 Q8.8       "), t, overhead);
+
+    Serial.println(F("================================"));
+}
+
+void loop() {
+}
@@ -1,15 +1,13 @@
 #include <Arduino.h>
-
-#define RELAY_PIN 6
-#define STATUS_LED 13
+#include <Board.h>
 
 bool pumpRunning = false;
 unsigned long pumpStartTime = 0;
 
 void pumpON() {
     Serial.println("Pump ON");
-    digitalWrite(RELAY_PIN, HIGH);
-    digitalWrite(STATUS_LED, HIGH);
+    RelayPin::high();
+    StatusLed::high();
     pumpRunning = true;
     pumpStartTime = millis();
 }
@@ -0,0 +1,103 @@
+# SmartCool Parasol - KY-013 NTC 온도 표 생성 (PlatformIO extra_scripts, 단독 실행 가능)
+#
+# Steinhart-Hart 식으로 ADC 원시값 → 온도(Q8.8) 표를 만들어
+# lib/SmartCool/Ky013Table.h 로 쓴다. 펌웨어는 이 표를 플래시에서 읽어 정수 보간만 한다.
+# 내용이 같으면 파일을 건드리지 않으므로 매 빌드 다시 컴파일되지 않는다.
+#
+#   [env:uno]
+#   extra_scripts = pre:tools/gen_ky013_table.py
+#
+#   python3 tools/gen_ky013_table.py     # 직접 다시 만들기
+#
+# 배선 (KY-013 모듈): VCC - NTC - S - 10kΩ - GND
+# 온도가 오르면 NTC 저항이 줄어 원시값이 커진다 (포텐셔미터와 같은 방향).
+
+import math
+import os
+
+SERIES_OHMS = 10000
+# KY-013 예제와 같은 10kΩ NTC 계수: 1/T = A + B ln R + C (ln R)^3
+SH_A = 1.009249522e-03
+SH_B = 2.378405444e-04
+SH_C = 2.019202697e-07
+
+ADC_MAX = 1023
+SHIFT = 4                       # 16 원시값 간격 → 65개 (130바이트)
+STEP = 1 << SHIFT
+SIZE = (ADC_MAX >> SHIFT) + 2   # 마지막 구간의 오른쪽 끝까지
+Q_ONE = 256
+
+HEADER = "Ky013Table.h"
+
+
+def celsius(raw):
+    # 양 끝(0, 1023 이상)은 저항이 무한대/0이 되므로 가장 가까운 유효값으로
+    raw = min(max(raw, 1), ADC_MAX - 1)
+    ntc = SERIES_OHMS * (ADC_MAX / float(raw) - 1.0)
+    ln = math.log(ntc)
+    return 1.0 / (SH_A + SH_B * ln + SH_C * ln ** 3) - 273.15
+
+
+def q88(c):
+    # Q8.8 표현 범위(-128 ~ 127.99°C)에서 포화
+    return max(-32768, min(32767, int(round(c * Q_ONE))))
+
+
+def render():
+    values = [q88(celsius(i * STEP)) for i in range(SIZE)]
+    rows = []
+    for start in range(0, SIZE, 8):
+        chunk = values[start:start + 8]
+        rows.append("    " + ", ".join("%6d" % v for v in chunk) + ",  // raw %d~" % (start * STEP))
+
+    return """/*
+ * SmartCool Parasol - KY-013 NTC 원시값 → 온도 표 (Q8.8 °C)
+ *
+ * 자동 생성 파일: tools/gen_ky013_table.py 가 만든다. 직접 고치지 말 것.
+ * 배선 VCC - NTC - S - %(series)dΩ - GND, Steinhart-Hart A=%(a).9e B=%(b).9e C=%(c).9e
+ * 표[i] = 원시값 i × %(step)d 의 온도. 사이 값은 SensorConversion.h가 선형 보간한다.
+ */
+
+#ifndef SMARTCOOL_KY013_TABLE_H
+#define SMARTCOOL_KY013_TABLE_H
+
+#include <stdint.h>
+#include "Progmem.h"
+
+const uint32_t KY013_SERIES_OHMS = %(series)d;
+constexpr double KY013_SH_A = %(a).9e;     // 호스트 검증용 (펌웨어에는 링크되지 않음)
+constexpr double KY013_SH_B = %(b).9e;
+constexpr double KY013_SH_C = %(c).9e;
+
+const uint8_t KY013_TABLE_SHIFT = %(shift)d;
+const uint8_t KY013_TABLE_SIZE = %(size)d;
+
+constexpr int16_t KY013_TABLE[KY013_TABLE_SIZE] PROGMEM = {
+%(rows)s
+};
+
+#endif
+""" % {
+        "series": SERIES_OHMS, "a": SH_A, "b": SH_B, "c": SH_C,
+        "step": STEP, "shift": SHIFT, "size": SIZE, "rows": "\n".join(rows),
+    }
+
+
+def generate(root):
+    path = os.path.normpath(os.path.join(root, "lib", "SmartCool", HEADER))
+    text = render()
+    old = None
+    if os.path.exists(path):
+        with open(path, encoding="utf-8") as f:
+            old = f.read()
+    if old != text:
+        with open(path, "w", encoding="utf-8") as f:
+            f.write(text)
+        print("KY-013 표 생성: %s" % path)
+
+
+try:
+    Import("env")
+    generate(env.subst("$PROJECT_DIR"))
+except NameError:
+    generate(os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
@@ -0,0 +1,64 @@
+# SmartCool Parasol - 빌드 후 정적 SRAM 예산 보고 (PlatformIO extra_scripts)
+#
+# .data + .bss 합계와 가장 큰 RAM 심볼을 출력하고, custom_sram_budget(바이트)을
+# 넘으면 빌드를 실패시킨다. 나머지 SRAM은 스택과 힙 몫이다.
+#
+#   [env:uno]
+#   extra_scripts = post:tools/sram_report.py
+#   custom_sram_budget = 1280
+
+import subprocess
+
+Import("env")
+
+TOP_SYMBOLS = 12
+
+
+def tool(name):
+    # avr-g++ 옆의 avr-nm / avr-size
+    return env.subst("$CC").replace("gcc", name)
+
+
+def ram_symbols(elf):
+    out = subprocess.check_output([tool("nm"), "-C", "-S", "--size-sort", elf],
+                                  universal_newlines=True)
+    symbols = []
+    for line in out.splitlines():
+        parts = line.split(None, 3)
+        if len(parts) == 4 and parts[2].lower() in ("b", "d"):
+            symbols.append((int(parts[1], 16), parts[2].lower(), parts[3]))
+    symbols.sort(reverse=True)
+    return symbols
+
+
+def section_sizes(elf):
+    out = subprocess.check_output([tool("size"), "-A", elf], universal_newlines=True)
+    sizes = {}
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) >= 2 and parts[0] in (".data", ".bss", ".noinit"):
+            sizes[parts[0]] = int(parts[1])
+    return sizes
+
+
+def report(source, target, env):
+    elf = str(source[0])
+    sizes = section_sizes(elf)
+    static = sum(sizes.values())
+    budget = int(env.GetProjectOption("custom_sram_budget", "0"))
+
+    print("===== 정적 SRAM (%s) =====" % env["PIOENV"])
+    for name in (".data", ".bss", ".noinit"):
+        if name in sizes:
+            print("  %-8s %5d B" % (name, sizes[name]))
+    print("  합계     %5d B" % static + (" / 예산 %d B" % budget if budget else ""))
+    print("  큰 심볼:")
+    for size, kind, name in ram_symbols(elf)[:TOP_SYMBOLS]:
+        print("    %5d B  %s  %s" % (size, kind, name))
+
+    if budget and static > budget:
+        print("정적 SRAM %d B가 예산 %d B를 넘었습니다" % (static, budget))
+        env.Exit(1)
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", report)